@@ -0,0 +1,162 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "Compiler.h"
+#include "Encoder.h"
+#include "Isa.h"
+#include "ObjectModule.h"
+#include "OldEncoder.h"
+
+using namespace std;
+
+//Checks the Encoder against the string encoder it replaced:
+//- every opcode of the old table with every operand descriptor in both places, the old words
+//  are made by the old functions below
+//- the lines of OldEncoder.h one by one through the assembler, they cover every addressing mode,
+//  the extra word and the 2 and 4 byte forms
+//./encoderCheck, the exit code is the number of differences
+
+
+//OLD STRING ENCODER, as it was in UtilFunctions
+static string decimalToBinary(int number) {
+	string bin = "";
+	while (number != 0) {
+		char c = number % 2 ? '1' : '0';
+		bin = c + bin;
+		number = number / 2;
+	}
+
+	while (bin.length() < 3) {
+		bin = "0" + bin;
+	}
+	return bin;
+}
+
+static string binaryToHexa(string binary) {
+	string hex = "", temp = "";
+	int k = binary.length();
+	for (int i = 0; i < k; i += 4) {
+		temp = binary.substr(i, 4);
+		if (temp == "0000")hex = hex + "0";
+		else if (temp == "0001")hex = hex + "1";
+		else if (temp == "0010")hex = hex + "2";
+		else if (temp == "0011")hex = hex + "3";
+		else if (temp == "0100")hex = hex + "4";
+		else if (temp == "0101")hex = hex + "5";
+		else if (temp == "0110")hex = hex + "6";
+		else if (temp == "0111")hex = hex + "7";
+		else if (temp == "1000")hex = hex + "8";
+		else if (temp == "1001")hex = hex + "9";
+		else if (temp == "1010")hex = hex + "A";
+		else if (temp == "1011")hex = hex + "B";
+		else if (temp == "1100")hex = hex + "C";
+		else if (temp == "1101")hex = hex + "D";
+		else if (temp == "1110")hex = hex + "E";
+		else if (temp == "1111")hex = hex + "F";
+		else continue;
+	}
+	return hex;
+}
+
+static string wordToHexa(uint16_t word) {
+	static const char* const digits = "0123456789ABCDEF";
+	string hex = "";
+	for (int shift = 12; shift >= 0; shift -= 4) hex += digits[(word >> shift) & 0xF];
+	return hex;
+}
+
+//operand as the old assembler wrote it and as the Encoder makes it
+struct Descriptor {
+	string bits;
+	uint8_t operand;
+};
+
+static vector<Descriptor> descriptors() {
+	vector<Descriptor> ret;
+	ret.push_back(Descriptor{ "00000", Encoder::immediate() });
+	ret.push_back(Descriptor{ "00111", Encoder::psw() });
+	ret.push_back(Descriptor{ "10000", Encoder::memory() });
+	for (int reg = 0; reg < 8; reg++) {
+		ret.push_back(Descriptor{ "01" + decimalToBinary(reg), Encoder::regDir(reg) });
+		ret.push_back(Descriptor{ "11" + decimalToBinary(reg), Encoder::regInd(reg) });
+	}
+	ret.push_back(Descriptor{ "01110", Encoder::regDir(Encoder::SP) });	//sp
+	ret.push_back(Descriptor{ "01111", Encoder::regDir(Encoder::PC) });	//pc
+	ret.push_back(Descriptor{ "11111", Encoder::pcRel() });
+	return ret;
+}
+
+//opcode the assembler uses now for a name of the old table
+static int opcode(string_view name) {
+	if (name.size() > 6 && name.substr(name.size() - 6) == "jmpadd") return Isa::opcode(name.substr(0, name.size() - 3));
+	if (name.size() > 6 && name.substr(name.size() - 6) == "jmpmov") return Encoder::opcode(Isa::condition(name), Isa::MOV);
+	return Isa::opcode(name);
+}
+
+static int checkWords() {
+	vector<Descriptor> operands = descriptors();
+	int differences = 0;
+	int words = 0;
+
+	for (const OldOpcode& op : OLD_OPCODES) {
+		string bits = op.bits;
+		//THE ONLY INTENDED DIFFERENCE, the old table gave neiret the opcode of eqiret
+		if (string(op.name) == "neiret") {
+			if (bits != "001100") differences++;
+			bits = "011100";
+		}
+
+		for (const Descriptor& first : operands) {
+			for (const Descriptor& second : operands) {
+				string old = binaryToHexa(bits + first.bits + second.bits);
+				string now = wordToHexa(Encoder::instruction(opcode(op.name), first.operand, second.operand));
+				words++;
+				if (old != now) {
+					differences++;
+					cout << op.name << " " << first.bits << " " << second.bits << ": old " << old << ", now " << now << endl;
+				}
+			}
+		}
+	}
+
+	cout << words << " instruction words compared" << endl;
+	return differences;
+}
+
+static int checkLines() {
+	Compiler compiler;
+	int differences = 0;
+	int lines = 0;
+
+	for (const OldLine& line : OLD_LINES) {
+		string source = string(".text\n ") + line.line + "\nx: .word 7\n.end\n";
+		ObjectModule object = compiler.assemble(source, 0);
+		lines++;
+
+		string now = "";
+		if (object.ok()) {
+			ObjectSection* text = object.getSection(".text");
+			if (text != 0) {
+				for (int i = 0; i < text->getBytes().size(); i++) now += wordToHexa(text->getBytes()[i]).substr(2);
+			}
+		}
+
+		if (line.code == 0 && !object.ok()) continue;
+		if (line.code != 0 && object.ok() && now == line.code) continue;
+
+		differences++;
+		cout << line.line << ": old " << (line.code == 0 ? "error" : line.code)
+			<< ", now " << (object.ok() ? now : object.getDiagnostics()[0].getMessage()) << endl;
+	}
+
+	cout << lines << " lines assembled" << endl;
+	return differences;
+}
+
+int main() {
+	int differences = checkWords() + checkLines();
+	if (differences == 0) cout << "Same as the old encoder" << endl;
+	else cout << differences << " differences" << endl;
+	return differences;
+}
@@ -0,0 +1,829 @@
+#ifndef OLDENCODER_H
+#define OLDENCODER_H
+
+//Made with the assembler of the first commit, before the Encoder replaced its strings, do not edit.
+
+//Instruction::instructions of the old assembler, jmp has an add and a mov form
+struct OldOpcode {
+	const char* name;
+	const char* bits;
+};
+
+static const OldOpcode OLD_OPCODES[] = {
+	{ "eqadd", "000000" },
+	{ "eqsub", "000001" },
+	{ "eqmul", "000010" },
+	{ "eqdiv", "000011" },
+	{ "eqcmp", "000100" },
+	{ "eqand", "000101" },
+	{ "eqor", "000110" },
+	{ "eqnot", "000111" },
+	{ "eqtest", "001000" },
+	{ "eqpush", "001001" },
+	{ "eqpop", "001010" },
+	{ "eqcall", "001011" },
+	{ "eqiret", "001100" },
+	{ "eqmov", "001101" },
+	{ "eqshl", "001110" },
+	{ "eqshr", "001111" },
+	{ "neadd", "010000" },
+	{ "nesub", "010001" },
+	{ "nemul", "010010" },
+	{ "nediv", "010011" },
+	{ "necmp", "010100" },
+	{ "neand", "010101" },
+	{ "neor", "010110" },
+	{ "nenot", "010111" },
+	{ "netest", "011000" },
+	{ "nepush", "011001" },
+	{ "nepop", "011010" },
+	{ "necall", "011011" },
+	{ "neiret", "001100" },
+	{ "nemov", "011101" },
+	{ "neshl", "011110" },
+	{ "neshr", "011111" },
+	{ "gtadd", "100000" },
+	{ "gtsub", "100001" },
+	{ "gtmul", "100010" },
+	{ "gtdiv", "100011" },
+	{ "gtcmp", "100100" },
+	{ "gtand", "100101" },
+	{ "gtor", "100110" },
+	{ "gtnot", "100111" },
+	{ "gttest", "101000" },
+	{ "gtpush", "101001" },
+	{ "gtpop", "101010" },
+	{ "gtcall", "101011" },
+	{ "gtiret", "101100" },
+	{ "gtmov", "101101" },
+	{ "gtshl", "101110" },
+	{ "gtshr", "101111" },
+	{ "aladd", "110000" },
+	{ "alsub", "110001" },
+	{ "almul", "110010" },
+	{ "aldiv", "110011" },
+	{ "alcmp", "110100" },
+	{ "aland", "110101" },
+	{ "alor", "110110" },
+	{ "alnot", "110111" },
+	{ "altest", "111000" },
+	{ "alpush", "111001" },
+	{ "alpop", "111010" },
+	{ "alcall", "111011" },
+	{ "aliret", "111100" },
+	{ "almov", "111101" },
+	{ "alshl", "111110" },
+	{ "alshr", "111111" },
+	{ "eqret", "001010" },
+	{ "neret", "011010" },
+	{ "gtret", "101010" },
+	{ "alret", "111010" },
+	{ "eqjmpadd", "000000" },
+	{ "nejmpadd", "010000" },
+	{ "gtjmpadd", "100000" },
+	{ "aljmpadd", "110000" },
+	{ "eqjmpmov", "001101" },
+	{ "nejmpmov", "011101" },
+	{ "gtjmpmov", "101101" },
+	{ "aljmpmov", "111101" },
+};
+
+//Every source is ".text", the line, "x: .word 7" and ".end", the code is the whole .text of the old object
+//(hex digits of immediates upper case, the old one copied them as written), 0 if the old assembler rejected the line.
+//neiret is left out, the old table gave it the eqiret opcode.
+struct OldLine {
+	const char* line;
+	const char* code;
+};
+
+static const OldLine OLD_LINES[] = {
+	{ "eqadd r1, r2", "012A0700" },
+	{ "eqsub r1, r2", "052A0700" },
+	{ "eqmul r1, r2", "092A0700" },
+	{ "eqdiv r1, r2", "0D2A0700" },
+	{ "eqcmp r1, r2", "112A0700" },
+	{ "eqand r1, r2", "152A0700" },
+	{ "eqor r1, r2", "192A0700" },
+	{ "eqnot r1, r2", "1D2A0700" },
+	{ "eqtest r1, r2", "212A0700" },
+	{ "eqmov r1, r2", "352A0700" },
+	{ "eqshl r1, r2", "392A0700" },
+	{ "eqshr r1, r2", "3D2A0700" },
+	{ "eqpush r1", "24090700" },
+	{ "eqpop r1", "29200700" },
+	{ "eqcall r1", "2C090700" },
+	{ "eqjmp r1", "35E90700" },
+	{ "eqiret", "30000700" },
+	{ "eqret", "29E00700" },
+	{ "neadd r1, r2", "412A0700" },
+	{ "nesub r1, r2", "452A0700" },
+	{ "nemul r1, r2", "492A0700" },
+	{ "nediv r1, r2", "4D2A0700" },
+	{ "necmp r1, r2", "512A0700" },
+	{ "neand r1, r2", "552A0700" },
+	{ "neor r1, r2", "592A0700" },
+	{ "nenot r1, r2", "5D2A0700" },
+	{ "netest r1, r2", "612A0700" },
+	{ "nemov r1, r2", "752A0700" },
+	{ "neshl r1, r2", "792A0700" },
+	{ "neshr r1, r2", "7D2A0700" },
+	{ "nepush r1", "64090700" },
+	{ "nepop r1", "69200700" },
+	{ "necall r1", "6C090700" },
+	{ "nejmp r1", "75E90700" },
+	{ "neret", "69E00700" },
+	{ "gtadd r1, r2", "812A0700" },
+	{ "gtsub r1, r2", "852A0700" },
+	{ "gtmul r1, r2", "892A0700" },
+	{ "gtdiv r1, r2", "8D2A0700" },
+	{ "gtcmp r1, r2", "912A0700" },
+	{ "gtand r1, r2", "952A0700" },
+	{ "gtor r1, r2", "992A0700" },
+	{ "gtnot r1, r2", "9D2A0700" },
+	{ "gttest r1, r2", "A12A0700" },
+	{ "gtmov r1, r2", "B52A0700" },
+	{ "gtshl r1, r2", "B92A0700" },
+	{ "gtshr r1, r2", "BD2A0700" },
+	{ "gtpush r1", "A4090700" },
+	{ "gtpop r1", "A9200700" },
+	{ "gtcall r1", "AC090700" },
+	{ "gtjmp r1", "B5E90700" },
+	{ "gtiret", "B0000700" },
+	{ "gtret", "A9E00700" },
+	{ "aladd r1, r2", "C12A0700" },
+	{ "alsub r1, r2", "C52A0700" },
+	{ "almul r1, r2", "C92A0700" },
+	{ "aldiv r1, r2", "CD2A0700" },
+	{ "alcmp r1, r2", "D12A0700" },
+	{ "aland r1, r2", "D52A0700" },
+	{ "alor r1, r2", "D92A0700" },
+	{ "alnot r1, r2", "DD2A0700" },
+	{ "altest r1, r2", "E12A0700" },
+	{ "almov r1, r2", "F52A0700" },
+	{ "alshl r1, r2", "F92A0700" },
+	{ "alshr r1, r2", "FD2A0700" },
+	{ "alpush r1", "E4090700" },
+	{ "alpop r1", "E9200700" },
+	{ "alcall r1", "EC090700" },
+	{ "aljmp r1", "F5E90700" },
+	{ "aliret", "F0000700" },
+	{ "alret", "E9E00700" },
+	{ "aladd r1, r1", "C1290700" },
+	{ "aladd r1, r6", "C12E0700" },
+	{ "aladd r1, sp", "C12E0700" },
+	{ "aladd r1, pc", "C12F0700" },
+	{ "aladd r1, psw", "C1270700" },
+	{ "aladd r1, *20", "C13014000700" },
+	{ "aladd r1, *0x10", "C13010000700" },
+	{ "aladd r1, x", "C13004000700" },
+	{ "aladd r1, r3[0]", "C13B00000700" },
+	{ "aladd r1, r3[5]", "C13B05000700" },
+	{ "aladd r1, r3[0x12]", "C13B02000700" },
+	{ "aladd r1, r3[x]", "C13B04000700" },
+	{ "aladd r1, r7[x]", "C13F02000700" },
+	{ "aladd r1, $x", "C13F02000700" },
+	{ "aladd r1, 5", "C12005000700" },
+	{ "aladd r1, 0x1f", "C1200F000700" },
+	{ "aladd r1, &x", "C12004000700" },
+	{ "aladd r6, r1", "C1C90700" },
+	{ "aladd r6, r6", "C1CE0700" },
+	{ "aladd r6, sp", "C1CE0700" },
+	{ "aladd r6, pc", "C1CF0700" },
+	{ "aladd r6, psw", "C1C70700" },
+	{ "aladd r6, *20", "C1D014000700" },
+	{ "aladd r6, *0x10", "C1D010000700" },
+	{ "aladd r6, x", "C1D004000700" },
+	{ "aladd r6, r3[0]", "C1DB00000700" },
+	{ "aladd r6, r3[5]", "C1DB05000700" },
+	{ "aladd r6, r3[0x12]", "C1DB02000700" },
+	{ "aladd r6, r3[x]", "C1DB04000700" },
+	{ "aladd r6, r7[x]", "C1DF02000700" },
+	{ "aladd r6, $x", "C1DF02000700" },
+	{ "aladd r6, 5", "C1C005000700" },
+	{ "aladd r6, 0x1f", "C1C00F000700" },
+	{ "aladd r6, &x", "C1C004000700" },
+	{ "aladd sp, r1", "C1C90700" },
+	{ "aladd sp, r6", "C1CE0700" },
+	{ "aladd sp, sp", "C1CE0700" },
+	{ "aladd sp, pc", "C1CF0700" },
+	{ "aladd sp, psw", "C1C70700" },
+	{ "aladd sp, *20", "C1D014000700" },
+	{ "aladd sp, *0x10", "C1D010000700" },
+	{ "aladd sp, x", "C1D004000700" },
+	{ "aladd sp, r3[0]", "C1DB00000700" },
+	{ "aladd sp, r3[5]", "C1DB05000700" },
+	{ "aladd sp, r3[0x12]", "C1DB02000700" },
+	{ "aladd sp, r3[x]", "C1DB04000700" },
+	{ "aladd sp, r7[x]", "C1DF02000700" },
+	{ "aladd sp, $x", "C1DF02000700" },
+	{ "aladd sp, 5", "C1C005000700" },
+	{ "aladd sp, 0x1f", "C1C00F000700" },
+	{ "aladd sp, &x", "C1C004000700" },
+	{ "aladd pc, r1", "C1E90700" },
+	{ "aladd pc, r6", "C1EE0700" },
+	{ "aladd pc, sp", "C1EE0700" },
+	{ "aladd pc, pc", "C1EF0700" },
+	{ "aladd pc, psw", "C1E70700" },
+	{ "aladd pc, *20", "C1F014000700" },
+	{ "aladd pc, *0x10", "C1F010000700" },
+	{ "aladd pc, x", "C1F004000700" },
+	{ "aladd pc, r3[0]", "C1FB00000700" },
+	{ "aladd pc, r3[5]", "C1FB05000700" },
+	{ "aladd pc, r3[0x12]", "C1FB02000700" },
+	{ "aladd pc, r3[x]", "C1FB04000700" },
+	{ "aladd pc, r7[x]", "C1FF02000700" },
+	{ "aladd pc, $x", "C1FF02000700" },
+	{ "aladd pc, 5", "C1E005000700" },
+	{ "aladd pc, 0x1f", "C1E00F000700" },
+	{ "aladd pc, &x", "C1E004000700" },
+	{ "aladd psw, r1", "C0E90700" },
+	{ "aladd psw, r6", "C0EE0700" },
+	{ "aladd psw, sp", "C0EE0700" },
+	{ "aladd psw, pc", "C0EF0700" },
+	{ "aladd psw, psw", "C0E70700" },
+	{ "aladd psw, *20", "C0F014000700" },
+	{ "aladd psw, *0x10", "C0F010000700" },
+	{ "aladd psw, x", "C0F004000700" },
+	{ "aladd psw, r3[0]", "C0FB00000700" },
+	{ "aladd psw, r3[5]", "C0FB05000700" },
+	{ "aladd psw, r3[0x12]", "C0FB02000700" },
+	{ "aladd psw, r3[x]", "C0FB04000700" },
+	{ "aladd psw, r7[x]", "C0FF02000700" },
+	{ "aladd psw, $x", "C0FF02000700" },
+	{ "aladd psw, 5", "C0E005000700" },
+	{ "aladd psw, 0x1f", "C0E00F000700" },
+	{ "aladd psw, &x", "C0E004000700" },
+	{ "aladd *20, r1", "C20914000700" },
+	{ "aladd *20, r6", "C20E14000700" },
+	{ "aladd *20, sp", "C20E14000700" },
+	{ "aladd *20, pc", "C20F14000700" },
+	{ "aladd *20, psw", "C20714000700" },
+	{ "aladd *20, *20", 0 },
+	{ "aladd *20, *0x10", 0 },
+	{ "aladd *20, x", 0 },
+	{ "aladd *20, r3[0]", 0 },
+	{ "aladd *20, r3[5]", 0 },
+	{ "aladd *20, r3[0x12]", 0 },
+	{ "aladd *20, r3[x]", 0 },
+	{ "aladd *20, r7[x]", 0 },
+	{ "aladd *20, $x", 0 },
+	{ "aladd *20, 5", 0 },
+	{ "aladd *20, 0x1f", 0 },
+	{ "aladd *20, &x", 0 },
+	{ "aladd *0x10, r1", "C20910000700" },
+	{ "aladd *0x10, r6", "C20E10000700" },
+	{ "aladd *0x10, sp", "C20E10000700" },
+	{ "aladd *0x10, pc", "C20F10000700" },
+	{ "aladd *0x10, psw", "C20710000700" },
+	{ "aladd *0x10, *20", 0 },
+	{ "aladd *0x10, *0x10", 0 },
+	{ "aladd *0x10, x", 0 },
+	{ "aladd *0x10, r3[0]", 0 },
+	{ "aladd *0x10, r3[5]", 0 },
+	{ "aladd *0x10, r3[0x12]", 0 },
+	{ "aladd *0x10, r3[x]", 0 },
+	{ "aladd *0x10, r7[x]", 0 },
+	{ "aladd *0x10, $x", 0 },
+	{ "aladd *0x10, 5", 0 },
+	{ "aladd *0x10, 0x1f", 0 },
+	{ "aladd *0x10, &x", 0 },
+	{ "aladd x, r1", "C20904000700" },
+	{ "aladd x, r6", "C20E04000700" },
+	{ "aladd x, sp", "C20E04000700" },
+	{ "aladd x, pc", "C20F04000700" },
+	{ "aladd x, psw", "C20704000700" },
+	{ "aladd x, *20", 0 },
+	{ "aladd x, *0x10", 0 },
+	{ "aladd x, x", 0 },
+	{ "aladd x, r3[0]", 0 },
+	{ "aladd x, r3[5]", 0 },
+	{ "aladd x, r3[0x12]", 0 },
+	{ "aladd x, r3[x]", 0 },
+	{ "aladd x, r7[x]", 0 },
+	{ "aladd x, $x", 0 },
+	{ "aladd x, 5", 0 },
+	{ "aladd x, 0x1f", 0 },
+	{ "aladd x, &x", 0 },
+	{ "aladd r3[0], r1", "C36900000700" },
+	{ "aladd r3[0], r6", "C36E00000700" },
+	{ "aladd r3[0], sp", "C36E00000700" },
+	{ "aladd r3[0], pc", "C36F00000700" },
+	{ "aladd r3[0], psw", "C36700000700" },
+	{ "aladd r3[0], *20", 0 },
+	{ "aladd r3[0], *0x10", 0 },
+	{ "aladd r3[0], x", 0 },
+	{ "aladd r3[0], r3[0]", 0 },
+	{ "aladd r3[0], r3[5]", 0 },
+	{ "aladd r3[0], r3[0x12]", 0 },
+	{ "aladd r3[0], r3[x]", 0 },
+	{ "aladd r3[0], r7[x]", 0 },
+	{ "aladd r3[0], $x", 0 },
+	{ "aladd r3[0], 5", 0 },
+	{ "aladd r3[0], 0x1f", 0 },
+	{ "aladd r3[0], &x", 0 },
+	{ "aladd r3[5], r1", "C36905000700" },
+	{ "aladd r3[5], r6", "C36E05000700" },
+	{ "aladd r3[5], sp", "C36E05000700" },
+	{ "aladd r3[5], pc", "C36F05000700" },
+	{ "aladd r3[5], psw", "C36705000700" },
+	{ "aladd r3[5], *20", 0 },
+	{ "aladd r3[5], *0x10", 0 },
+	{ "aladd r3[5], x", 0 },
+	{ "aladd r3[5], r3[0]", 0 },
+	{ "aladd r3[5], r3[5]", 0 },
+	{ "aladd r3[5], r3[0x12]", 0 },
+	{ "aladd r3[5], r3[x]", 0 },
+	{ "aladd r3[5], r7[x]", 0 },
+	{ "aladd r3[5], $x", 0 },
+	{ "aladd r3[5], 5", 0 },
+	{ "aladd r3[5], 0x1f", 0 },
+	{ "aladd r3[5], &x", 0 },
+	{ "aladd r3[0x12], r1", "C36902000700" },
+	{ "aladd r3[0x12], r6", "C36E02000700" },
+	{ "aladd r3[0x12], sp", "C36E02000700" },
+	{ "aladd r3[0x12], pc", "C36F02000700" },
+	{ "aladd r3[0x12], psw", "C36702000700" },
+	{ "aladd r3[0x12], *20", 0 },
+	{ "aladd r3[0x12], *0x10", 0 },
+	{ "aladd r3[0x12], x", 0 },
+	{ "aladd r3[0x12], r3[0]", 0 },
+	{ "aladd r3[0x12], r3[5]", 0 },
+	{ "aladd r3[0x12], r3[0x12]", 0 },
+	{ "aladd r3[0x12], r3[x]", 0 },
+	{ "aladd r3[0x12], r7[x]", 0 },
+	{ "aladd r3[0x12], $x", 0 },
+	{ "aladd r3[0x12], 5", 0 },
+	{ "aladd r3[0x12], 0x1f", 0 },
+	{ "aladd r3[0x12], &x", 0 },
+	{ "aladd r3[x], r1", "C36904000700" },
+	{ "aladd r3[x], r6", "C36E04000700" },
+	{ "aladd r3[x], sp", "C36E04000700" },
+	{ "aladd r3[x], pc", "C36F04000700" },
+	{ "aladd r3[x], psw", "C36704000700" },
+	{ "aladd r3[x], *20", 0 },
+	{ "aladd r3[x], *0x10", 0 },
+	{ "aladd r3[x], x", 0 },
+	{ "aladd r3[x], r3[0]", 0 },
+	{ "aladd r3[x], r3[5]", 0 },
+	{ "aladd r3[x], r3[0x12]", 0 },
+	{ "aladd r3[x], r3[x]", 0 },
+	{ "aladd r3[x], r7[x]", 0 },
+	{ "aladd r3[x], $x", 0 },
+	{ "aladd r3[x], 5", 0 },
+	{ "aladd r3[x], 0x1f", 0 },
+	{ "aladd r3[x], &x", 0 },
+	{ "aladd r7[x], r1", "C3E902000700" },
+	{ "aladd r7[x], r6", "C3EE02000700" },
+	{ "aladd r7[x], sp", "C3EE02000700" },
+	{ "aladd r7[x], pc", "C3EF02000700" },
+	{ "aladd r7[x], psw", "C3E702000700" },
+	{ "aladd r7[x], *20", 0 },
+	{ "aladd r7[x], *0x10", 0 },
+	{ "aladd r7[x], x", 0 },
+	{ "aladd r7[x], r3[0]", 0 },
+	{ "aladd r7[x], r3[5]", 0 },
+	{ "aladd r7[x], r3[0x12]", 0 },
+	{ "aladd r7[x], r3[x]", 0 },
+	{ "aladd r7[x], r7[x]", 0 },
+	{ "aladd r7[x], $x", 0 },
+	{ "aladd r7[x], 5", 0 },
+	{ "aladd r7[x], 0x1f", 0 },
+	{ "aladd r7[x], &x", 0 },
+	{ "aladd $x, r1", "C3E902000700" },
+	{ "aladd $x, r6", "C3EE02000700" },
+	{ "aladd $x, sp", "C3EE02000700" },
+	{ "aladd $x, pc", "C3EF02000700" },
+	{ "aladd $x, psw", "C3E702000700" },
+	{ "aladd $x, *20", 0 },
+	{ "aladd $x, *0x10", 0 },
+	{ "aladd $x, x", 0 },
+	{ "aladd $x, r3[0]", 0 },
+	{ "aladd $x, r3[5]", 0 },
+	{ "aladd $x, r3[0x12]", 0 },
+	{ "aladd $x, r3[x]", 0 },
+	{ "aladd $x, r7[x]", 0 },
+	{ "aladd $x, $x", 0 },
+	{ "aladd $x, 5", 0 },
+	{ "aladd $x, 0x1f", 0 },
+	{ "aladd $x, &x", 0 },
+	{ "aladd 5, r1", 0 },
+	{ "aladd 5, r6", 0 },
+	{ "aladd 5, sp", 0 },
+	{ "aladd 5, pc", 0 },
+	{ "aladd 5, psw", 0 },
+	{ "aladd 5, *20", 0 },
+	{ "aladd 5, *0x10", 0 },
+	{ "aladd 5, x", 0 },
+	{ "aladd 5, r3[0]", 0 },
+	{ "aladd 5, r3[5]", 0 },
+	{ "aladd 5, r3[0x12]", 0 },
+	{ "aladd 5, r3[x]", 0 },
+	{ "aladd 5, r7[x]", 0 },
+	{ "aladd 5, $x", 0 },
+	{ "aladd 5, 5", 0 },
+	{ "aladd 5, 0x1f", 0 },
+	{ "aladd 5, &x", 0 },
+	{ "aladd &x, r1", 0 },
+	{ "aladd &x, r6", 0 },
+	{ "aladd &x, sp", 0 },
+	{ "aladd &x, pc", 0 },
+	{ "aladd &x, psw", 0 },
+	{ "aladd &x, *20", 0 },
+	{ "aladd &x, *0x10", 0 },
+	{ "aladd &x, x", 0 },
+	{ "aladd &x, r3[0]", 0 },
+	{ "aladd &x, r3[5]", 0 },
+	{ "aladd &x, r3[0x12]", 0 },
+	{ "aladd &x, r3[x]", 0 },
+	{ "aladd &x, r7[x]", 0 },
+	{ "aladd &x, $x", 0 },
+	{ "aladd &x, 5", 0 },
+	{ "aladd &x, 0x1f", 0 },
+	{ "aladd &x, &x", 0 },
+	{ "alcmp r1, r1", "D1290700" },
+	{ "alcmp r1, r6", "D12E0700" },
+	{ "alcmp r1, sp", "D12E0700" },
+	{ "alcmp r1, pc", "D12F0700" },
+	{ "alcmp r1, psw", "D1270700" },
+	{ "alcmp r1, *20", "D13014000700" },
+	{ "alcmp r1, *0x10", "D13010000700" },
+	{ "alcmp r1, x", "D13004000700" },
+	{ "alcmp r1, r3[0]", "D13B00000700" },
+	{ "alcmp r1, r3[5]", "D13B05000700" },
+	{ "alcmp r1, r3[0x12]", "D13B02000700" },
+	{ "alcmp r1, r3[x]", "D13B04000700" },
+	{ "alcmp r1, r7[x]", "D13F02000700" },
+	{ "alcmp r1, $x", "D13F02000700" },
+	{ "alcmp r1, 5", "D12005000700" },
+	{ "alcmp r1, 0x1f", "D1200F000700" },
+	{ "alcmp r1, &x", "D12004000700" },
+	{ "alcmp r6, r1", "D1C90700" },
+	{ "alcmp r6, r6", "D1CE0700" },
+	{ "alcmp r6, sp", "D1CE0700" },
+	{ "alcmp r6, pc", "D1CF0700" },
+	{ "alcmp r6, psw", "D1C70700" },
+	{ "alcmp r6, *20", "D1D014000700" },
+	{ "alcmp r6, *0x10", "D1D010000700" },
+	{ "alcmp r6, x", "D1D004000700" },
+	{ "alcmp r6, r3[0]", "D1DB00000700" },
+	{ "alcmp r6, r3[5]", "D1DB05000700" },
+	{ "alcmp r6, r3[0x12]", "D1DB02000700" },
+	{ "alcmp r6, r3[x]", "D1DB04000700" },
+	{ "alcmp r6, r7[x]", "D1DF02000700" },
+	{ "alcmp r6, $x", "D1DF02000700" },
+	{ "alcmp r6, 5", "D1C005000700" },
+	{ "alcmp r6, 0x1f", "D1C00F000700" },
+	{ "alcmp r6, &x", "D1C004000700" },
+	{ "alcmp sp, r1", "D1C90700" },
+	{ "alcmp sp, r6", "D1CE0700" },
+	{ "alcmp sp, sp", "D1CE0700" },
+	{ "alcmp sp, pc", "D1CF0700" },
+	{ "alcmp sp, psw", "D1C70700" },
+	{ "alcmp sp, *20", "D1D014000700" },
+	{ "alcmp sp, *0x10", "D1D010000700" },
+	{ "alcmp sp, x", "D1D004000700" },
+	{ "alcmp sp, r3[0]", "D1DB00000700" },
+	{ "alcmp sp, r3[5]", "D1DB05000700" },
+	{ "alcmp sp, r3[0x12]", "D1DB02000700" },
+	{ "alcmp sp, r3[x]", "D1DB04000700" },
+	{ "alcmp sp, r7[x]", "D1DF02000700" },
+	{ "alcmp sp, $x", "D1DF02000700" },
+	{ "alcmp sp, 5", "D1C005000700" },
+	{ "alcmp sp, 0x1f", "D1C00F000700" },
+	{ "alcmp sp, &x", "D1C004000700" },
+	{ "alcmp pc, r1", "D1E90700" },
+	{ "alcmp pc, r6", "D1EE0700" },
+	{ "alcmp pc, sp", "D1EE0700" },
+	{ "alcmp pc, pc", "D1EF0700" },
+	{ "alcmp pc, psw", "D1E70700" },
+	{ "alcmp pc, *20", "D1F014000700" },
+	{ "alcmp pc, *0x10", "D1F010000700" },
+	{ "alcmp pc, x", "D1F004000700" },
+	{ "alcmp pc, r3[0]", "D1FB00000700" },
+	{ "alcmp pc, r3[5]", "D1FB05000700" },
+	{ "alcmp pc, r3[0x12]", "D1FB02000700" },
+	{ "alcmp pc, r3[x]", "D1FB04000700" },
+	{ "alcmp pc, r7[x]", "D1FF02000700" },
+	{ "alcmp pc, $x", "D1FF02000700" },
+	{ "alcmp pc, 5", "D1E005000700" },
+	{ "alcmp pc, 0x1f", "D1E00F000700" },
+	{ "alcmp pc, &x", "D1E004000700" },
+	{ "alcmp psw, r1", "D0E90700" },
+	{ "alcmp psw, r6", "D0EE0700" },
+	{ "alcmp psw, sp", "D0EE0700" },
+	{ "alcmp psw, pc", "D0EF0700" },
+	{ "alcmp psw, psw", "D0E70700" },
+	{ "alcmp psw, *20", "D0F014000700" },
+	{ "alcmp psw, *0x10", "D0F010000700" },
+	{ "alcmp psw, x", "D0F004000700" },
+	{ "alcmp psw, r3[0]", "D0FB00000700" },
+	{ "alcmp psw, r3[5]", "D0FB05000700" },
+	{ "alcmp psw, r3[0x12]", "D0FB02000700" },
+	{ "alcmp psw, r3[x]", "D0FB04000700" },
+	{ "alcmp psw, r7[x]", "D0FF02000700" },
+	{ "alcmp psw, $x", "D0FF02000700" },
+	{ "alcmp psw, 5", "D0E005000700" },
+	{ "alcmp psw, 0x1f", "D0E00F000700" },
+	{ "alcmp psw, &x", "D0E004000700" },
+	{ "alcmp *20, r1", "D20914000700" },
+	{ "alcmp *20, r6", "D20E14000700" },
+	{ "alcmp *20, sp", "D20E14000700" },
+	{ "alcmp *20, pc", "D20F14000700" },
+	{ "alcmp *20, psw", "D20714000700" },
+	{ "alcmp *20, *20", 0 },
+	{ "alcmp *20, *0x10", 0 },
+	{ "alcmp *20, x", 0 },
+	{ "alcmp *20, r3[0]", 0 },
+	{ "alcmp *20, r3[5]", 0 },
+	{ "alcmp *20, r3[0x12]", 0 },
+	{ "alcmp *20, r3[x]", 0 },
+	{ "alcmp *20, r7[x]", 0 },
+	{ "alcmp *20, $x", 0 },
+	{ "alcmp *20, 5", 0 },
+	{ "alcmp *20, 0x1f", 0 },
+	{ "alcmp *20, &x", 0 },
+	{ "alcmp *0x10, r1", "D20910000700" },
+	{ "alcmp *0x10, r6", "D20E10000700" },
+	{ "alcmp *0x10, sp", "D20E10000700" },
+	{ "alcmp *0x10, pc", "D20F10000700" },
+	{ "alcmp *0x10, psw", "D20710000700" },
+	{ "alcmp *0x10, *20", 0 },
+	{ "alcmp *0x10, *0x10", 0 },
+	{ "alcmp *0x10, x", 0 },
+	{ "alcmp *0x10, r3[0]", 0 },
+	{ "alcmp *0x10, r3[5]", 0 },
+	{ "alcmp *0x10, r3[0x12]", 0 },
+	{ "alcmp *0x10, r3[x]", 0 },
+	{ "alcmp *0x10, r7[x]", 0 },
+	{ "alcmp *0x10, $x", 0 },
+	{ "alcmp *0x10, 5", 0 },
+	{ "alcmp *0x10, 0x1f", 0 },
+	{ "alcmp *0x10, &x", 0 },
+	{ "alcmp x, r1", "D20904000700" },
+	{ "alcmp x, r6", "D20E04000700" },
+	{ "alcmp x, sp", "D20E04000700" },
+	{ "alcmp x, pc", "D20F04000700" },
+	{ "alcmp x, psw", "D20704000700" },
+	{ "alcmp x, *20", 0 },
+	{ "alcmp x, *0x10", 0 },
+	{ "alcmp x, x", 0 },
+	{ "alcmp x, r3[0]", 0 },
+	{ "alcmp x, r3[5]", 0 },
+	{ "alcmp x, r3[0x12]", 0 },
+	{ "alcmp x, r3[x]", 0 },
+	{ "alcmp x, r7[x]", 0 },
+	{ "alcmp x, $x", 0 },
+	{ "alcmp x, 5", 0 },
+	{ "alcmp x, 0x1f", 0 },
+	{ "alcmp x, &x", 0 },
+	{ "alcmp r3[0], r1", "D36900000700" },
+	{ "alcmp r3[0], r6", "D36E00000700" },
+	{ "alcmp r3[0], sp", "D36E00000700" },
+	{ "alcmp r3[0], pc", "D36F00000700" },
+	{ "alcmp r3[0], psw", "D36700000700" },
+	{ "alcmp r3[0], *20", 0 },
+	{ "alcmp r3[0], *0x10", 0 },
+	{ "alcmp r3[0], x", 0 },
+	{ "alcmp r3[0], r3[0]", 0 },
+	{ "alcmp r3[0], r3[5]", 0 },
+	{ "alcmp r3[0], r3[0x12]", 0 },
+	{ "alcmp r3[0], r3[x]", 0 },
+	{ "alcmp r3[0], r7[x]", 0 },
+	{ "alcmp r3[0], $x", 0 },
+	{ "alcmp r3[0], 5", 0 },
+	{ "alcmp r3[0], 0x1f", 0 },
+	{ "alcmp r3[0], &x", 0 },
+	{ "alcmp r3[5], r1", "D36905000700" },
+	{ "alcmp r3[5], r6", "D36E05000700" },
+	{ "alcmp r3[5], sp", "D36E05000700" },
+	{ "alcmp r3[5], pc", "D36F05000700" },
+	{ "alcmp r3[5], psw", "D36705000700" },
+	{ "alcmp r3[5], *20", 0 },
+	{ "alcmp r3[5], *0x10", 0 },
+	{ "alcmp r3[5], x", 0 },
+	{ "alcmp r3[5], r3[0]", 0 },
+	{ "alcmp r3[5], r3[5]", 0 },
+	{ "alcmp r3[5], r3[0x12]", 0 },
+	{ "alcmp r3[5], r3[x]", 0 },
+	{ "alcmp r3[5], r7[x]", 0 },
+	{ "alcmp r3[5], $x", 0 },
+	{ "alcmp r3[5], 5", 0 },
+	{ "alcmp r3[5], 0x1f", 0 },
+	{ "alcmp r3[5], &x", 0 },
+	{ "alcmp r3[0x12], r1", "D36902000700" },
+	{ "alcmp r3[0x12], r6", "D36E02000700" },
+	{ "alcmp r3[0x12], sp", "D36E02000700" },
+	{ "alcmp r3[0x12], pc", "D36F02000700" },
+	{ "alcmp r3[0x12], psw", "D36702000700" },
+	{ "alcmp r3[0x12], *20", 0 },
+	{ "alcmp r3[0x12], *0x10", 0 },
+	{ "alcmp r3[0x12], x", 0 },
+	{ "alcmp r3[0x12], r3[0]", 0 },
+	{ "alcmp r3[0x12], r3[5]", 0 },
+	{ "alcmp r3[0x12], r3[0x12]", 0 },
+	{ "alcmp r3[0x12], r3[x]", 0 },
+	{ "alcmp r3[0x12], r7[x]", 0 },
+	{ "alcmp r3[0x12], $x", 0 },
+	{ "alcmp r3[0x12], 5", 0 },
+	{ "alcmp r3[0x12], 0x1f", 0 },
+	{ "alcmp r3[0x12], &x", 0 },
+	{ "alcmp r3[x], r1", "D36904000700" },
+	{ "alcmp r3[x], r6", "D36E04000700" },
+	{ "alcmp r3[x], sp", "D36E04000700" },
+	{ "alcmp r3[x], pc", "D36F04000700" },
+	{ "alcmp r3[x], psw", "D36704000700" },
+	{ "alcmp r3[x], *20", 0 },
+	{ "alcmp r3[x], *0x10", 0 },
+	{ "alcmp r3[x], x", 0 },
+	{ "alcmp r3[x], r3[0]", 0 },
+	{ "alcmp r3[x], r3[5]", 0 },
+	{ "alcmp r3[x], r3[0x12]", 0 },
+	{ "alcmp r3[x], r3[x]", 0 },
+	{ "alcmp r3[x], r7[x]", 0 },
+	{ "alcmp r3[x], $x", 0 },
+	{ "alcmp r3[x], 5", 0 },
+	{ "alcmp r3[x], 0x1f", 0 },
+	{ "alcmp r3[x], &x", 0 },
+	{ "alcmp r7[x], r1", "D3E902000700" },
+	{ "alcmp r7[x], r6", "D3EE02000700" },
+	{ "alcmp r7[x], sp", "D3EE02000700" },
+	{ "alcmp r7[x], pc", "D3EF02000700" },
+	{ "alcmp r7[x], psw", "D3E702000700" },
+	{ "alcmp r7[x], *20", 0 },
+	{ "alcmp r7[x], *0x10", 0 },
+	{ "alcmp r7[x], x", 0 },
+	{ "alcmp r7[x], r3[0]", 0 },
+	{ "alcmp r7[x], r3[5]", 0 },
+	{ "alcmp r7[x], r3[0x12]", 0 },
+	{ "alcmp r7[x], r3[x]", 0 },
+	{ "alcmp r7[x], r7[x]", 0 },
+	{ "alcmp r7[x], $x", 0 },
+	{ "alcmp r7[x], 5", 0 },
+	{ "alcmp r7[x], 0x1f", 0 },
+	{ "alcmp r7[x], &x", 0 },
+	{ "alcmp $x, r1", "D3E902000700" },
+	{ "alcmp $x, r6", "D3EE02000700" },
+	{ "alcmp $x, sp", "D3EE02000700" },
+	{ "alcmp $x, pc", "D3EF02000700" },
+	{ "alcmp $x, psw", "D3E702000700" },
+	{ "alcmp $x, *20", 0 },
+	{ "alcmp $x, *0x10", 0 },
+	{ "alcmp $x, x", 0 },
+	{ "alcmp $x, r3[0]", 0 },
+	{ "alcmp $x, r3[5]", 0 },
+	{ "alcmp $x, r3[0x12]", 0 },
+	{ "alcmp $x, r3[x]", 0 },
+	{ "alcmp $x, r7[x]", 0 },
+	{ "alcmp $x, $x", 0 },
+	{ "alcmp $x, 5", 0 },
+	{ "alcmp $x, 0x1f", 0 },
+	{ "alcmp $x, &x", 0 },
+	{ "alcmp 5, r1", "D00905000700" },
+	{ "alcmp 5, r6", "D00E05000700" },
+	{ "alcmp 5, sp", "D00E05000700" },
+	{ "alcmp 5, pc", "D00F05000700" },
+	{ "alcmp 5, psw", "D00705000700" },
+	{ "alcmp 5, *20", 0 },
+	{ "alcmp 5, *0x10", 0 },
+	{ "alcmp 5, x", 0 },
+	{ "alcmp 5, r3[0]", 0 },
+	{ "alcmp 5, r3[5]", 0 },
+	{ "alcmp 5, r3[0x12]", 0 },
+	{ "alcmp 5, r3[x]", 0 },
+	{ "alcmp 5, r7[x]", 0 },
+	{ "alcmp 5, $x", 0 },
+	{ "alcmp 5, 5", 0 },
+	{ "alcmp 5, 0x1f", 0 },
+	{ "alcmp 5, &x", 0 },
+	{ "alcmp &x, r1", "D00904000700" },
+	{ "alcmp &x, r6", "D00E04000700" },
+	{ "alcmp &x, sp", "D00E04000700" },
+	{ "alcmp &x, pc", "D00F04000700" },
+	{ "alcmp &x, psw", "D00704000700" },
+	{ "alcmp &x, *20", 0 },
+	{ "alcmp &x, *0x10", 0 },
+	{ "alcmp &x, x", 0 },
+	{ "alcmp &x, r3[0]", 0 },
+	{ "alcmp &x, r3[5]", 0 },
+	{ "alcmp &x, r3[0x12]", 0 },
+	{ "alcmp &x, r3[x]", 0 },
+	{ "alcmp &x, r7[x]", 0 },
+	{ "alcmp &x, $x", 0 },
+	{ "alcmp &x, 5", 0 },
+	{ "alcmp &x, 0x1f", 0 },
+	{ "alcmp &x, &x", 0 },
+	{ "alpush r6", "E40E0700" },
+	{ "alpush sp", "E40E0700" },
+	{ "alpush pc", "E40F0700" },
+	{ "alpush psw", "E4070700" },
+	{ "alpush *20", "E41014000700" },
+	{ "alpush *0x10", "E41010000700" },
+	{ "alpush x", "E41004000700" },
+	{ "alpush r3[0]", "E41B00000700" },
+	{ "alpush r3[5]", "E41B05000700" },
+	{ "alpush r3[0x12]", "E41B02000700" },
+	{ "alpush r3[x]", "E41B04000700" },
+	{ "alpush r7[x]", "E41F02000700" },
+	{ "alpush $x", "E41F02000700" },
+	{ "alpush 5", "E40005000700" },
+	{ "alpush 0x1f", "E4000F000700" },
+	{ "alpush &x", "E40004000700" },
+	{ "alpop r6", "E9C00700" },
+	{ "alpop sp", "E9C00700" },
+	{ "alpop pc", "E9E00700" },
+	{ "alpop psw", "E8E00700" },
+	{ "alpop *20", "EA0014000700" },
+	{ "alpop *0x10", "EA0010000700" },
+	{ "alpop x", "EA0004000700" },
+	{ "alpop r3[0]", "EB6000000700" },
+	{ "alpop r3[5]", "EB6005000700" },
+	{ "alpop r3[0x12]", "EB6002000700" },
+	{ "alpop r3[x]", "EB6004000700" },
+	{ "alpop r7[x]", "EBE002000700" },
+	{ "alpop $x", "EBE002000700" },
+	{ "alpop 5", 0 },
+	{ "alpop 0x1f", 0 },
+	{ "alpop &x", 0 },
+	{ "alcall r6", "EC0E0700" },
+	{ "alcall sp", "EC0E0700" },
+	{ "alcall pc", "EC0F0700" },
+	{ "alcall psw", "EC070700" },
+	{ "alcall *20", "EC1014000700" },
+	{ "alcall *0x10", "EC1010000700" },
+	{ "alcall x", "EC1004000700" },
+	{ "alcall r3[0]", "EC1B00000700" },
+	{ "alcall r3[5]", "EC1B05000700" },
+	{ "alcall r3[0x12]", "EC1B02000700" },
+	{ "alcall r3[x]", "EC1B04000700" },
+	{ "alcall r7[x]", "EC1F02000700" },
+	{ "alcall $x", "EC1F02000700" },
+	{ "alcall 5", "EC0005000700" },
+	{ "alcall 0x1f", "EC000F000700" },
+	{ "alcall &x", "EC0004000700" },
+	{ "eqjmp r6", "35EE0700" },
+	{ "eqjmp sp", "35EE0700" },
+	{ "eqjmp pc", "35EF0700" },
+	{ "eqjmp psw", "35E70700" },
+	{ "eqjmp *20", "35F014000700" },
+	{ "eqjmp *0x10", "35F010000700" },
+	{ "eqjmp x", "35F004000700" },
+	{ "eqjmp r3[0]", "35FB00000700" },
+	{ "eqjmp r3[5]", "35FB05000700" },
+	{ "eqjmp r3[0x12]", "35FB02000700" },
+	{ "eqjmp r3[x]", "35FB04000700" },
+	{ "eqjmp r7[x]", "35FF02000700" },
+	{ "eqjmp $x", "01E002000700" },
+	{ "eqjmp 5", "35E005000700" },
+	{ "eqjmp 0x1f", "35E00F000700" },
+	{ "eqjmp &x", "35E004000700" },
+	{ "nejmp r6", "75EE0700" },
+	{ "nejmp sp", "75EE0700" },
+	{ "nejmp pc", "75EF0700" },
+	{ "nejmp psw", "75E70700" },
+	{ "nejmp *20", "75F014000700" },
+	{ "nejmp *0x10", "75F010000700" },
+	{ "nejmp x", "75F004000700" },
+	{ "nejmp r3[0]", "75FB00000700" },
+	{ "nejmp r3[5]", "75FB05000700" },
+	{ "nejmp r3[0x12]", "75FB02000700" },
+	{ "nejmp r3[x]", "75FB04000700" },
+	{ "nejmp r7[x]", "75FF02000700" },
+	{ "nejmp $x", "41E002000700" },
+	{ "nejmp 5", "75E005000700" },
+	{ "nejmp 0x1f", "75E00F000700" },
+	{ "nejmp &x", "75E004000700" },
+	{ "gtjmp r6", "B5EE0700" },
+	{ "gtjmp sp", "B5EE0700" },
+	{ "gtjmp pc", "B5EF0700" },
+	{ "gtjmp psw", "B5E70700" },
+	{ "gtjmp *20", "B5F014000700" },
+	{ "gtjmp *0x10", "B5F010000700" },
+	{ "gtjmp x", "B5F004000700" },
+	{ "gtjmp r3[0]", "B5FB00000700" },
+	{ "gtjmp r3[5]", "B5FB05000700" },
+	{ "gtjmp r3[0x12]", "B5FB02000700" },
+	{ "gtjmp r3[x]", "B5FB04000700" },
+	{ "gtjmp r7[x]", "B5FF02000700" },
+	{ "gtjmp $x", "81E002000700" },
+	{ "gtjmp 5", "B5E005000700" },
+	{ "gtjmp 0x1f", "B5E00F000700" },
+	{ "gtjmp &x", "B5E004000700" },
+	{ "aljmp r6", "F5EE0700" },
+	{ "aljmp sp", "F5EE0700" },
+	{ "aljmp pc", "F5EF0700" },
+	{ "aljmp psw", "F5E70700" },
+	{ "aljmp *20", "F5F014000700" },
+	{ "aljmp *0x10", "F5F010000700" },
+	{ "aljmp x", "F5F004000700" },
+	{ "aljmp r3[0]", "F5FB00000700" },
+	{ "aljmp r3[5]", "F5FB05000700" },
+	{ "aljmp r3[0x12]", "F5FB02000700" },
+	{ "aljmp r3[x]", "F5FB04000700" },
+	{ "aljmp r7[x]", "F5FF02000700" },
+	{ "aljmp $x", "C1E002000700" },
+	{ "aljmp 5", "F5E005000700" },
+	{ "aljmp 0x1f", "F5E00F000700" },
+	{ "aljmp &x", "F5E004000700" },
+};
+
+#endif
@@ -0,0 +1,54 @@
+#include "AccessHeatmap.h"
+
+using namespace std;
+
+AccessHeatmap::AccessHeatmap(int initialSp) {
+	this->initialSp = initialSp;
+	minSp = initialSp;
+	lastPageNumber = 0;
+	lastPage = 0;
+}
+
+void AccessHeatmap::access(int address, AccessType type) {
+	int pageNumber = address >> Memory::PAGE_BITS;
+	if (lastPage == 0 || lastPageNumber != pageNumber) {
+		Counters zero = { 0, 0, 0 };
+		lastPage = &pages.insert(make_pair(pageNumber, zero)).first->second;
+		lastPageNumber = pageNumber;
+	}
+
+	if (type == FETCH) lastPage->executes++;
+	else if (type == READ || type == SYSTEM) lastPage->reads++;
+	else lastPage->writes++;
+}
+
+void AccessHeatmap::print(string fileName) {
+	ofstream out(fileName);
+	if (fileName.size() >= 5 && fileName.compare(fileName.size() - 5, 5, ".json") == 0) printJson(out);
+	else printCsv(out);
+}
+
+void AccessHeatmap::printCsv(ofstream& out) {
+	out << "page,start,reads,writes,executes" << endl;
+	for (map<int, Counters>::iterator it = pages.begin(); it != pages.end(); it++) {
+		Counters c = it->second;
+		out << it->first << "," << (it->first << Memory::PAGE_BITS) << "," << c.reads << "," << c.writes << "," << c.executes << endl;
+	}
+	out << "#min sp," << minSp << endl;
+	out << "#stack depth," << initialSp - minSp << endl;
+}
+
+void AccessHeatmap::printJson(ofstream& out) {
+	out << "{" << endl;
+	out << "  \"pageSize\": " << Memory::PAGE_SIZE << "," << endl;
+	out << "  \"minSp\": " << minSp << "," << endl;
+	out << "  \"stackDepth\": " << initialSp - minSp << "," << endl;
+	out << "  \"pages\": [";
+	for (map<int, Counters>::iterator it = pages.begin(); it != pages.end(); it++) {
+		Counters c = it->second;
+		if (it != pages.begin()) out << ",";
+		out << endl << "    { \"page\": " << it->first << ", \"start\": " << (it->first << Memory::PAGE_BITS)
+			<< ", \"reads\": " << c.reads << ", \"writes\": " << c.writes << ", \"executes\": " << c.executes << " }";
+	}
+	out << endl << "  ]" << endl << "}" << endl;
+}
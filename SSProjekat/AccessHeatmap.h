@@ -0,0 +1,47 @@
+#ifndef ACCESSHEATMAP_H
+#define ACCESSHEATMAP_H
+
+#include <map>
+#include <string>
+#include <fstream>
+
+#include "MemoryObserver.h"
+#include "Memory.h"
+
+using namespace std;
+
+
+//Per page read, write and execute counters plus the stack high-water mark,
+//cheap enough to leave on for every run
+class AccessHeatmap : public MemoryObserver {
+private:
+	struct Counters {
+		long long reads;
+		long long writes;
+		long long executes;
+	};
+
+	map<int, Counters> pages;
+	int lastPageNumber;
+	Counters* lastPage;
+
+	int initialSp;
+	int minSp;
+
+	void printCsv(ofstream& out);
+	void printJson(ofstream& out);
+
+public:
+	AccessHeatmap(int initialSp);
+	~AccessHeatmap() {}
+
+	void access(int address, AccessType type);
+	void observeSp(int sp) {
+		if (sp < minSp) minSp = sp;
+	}
+
+	//json if the file name ends with .json, csv otherwise
+	void print(string fileName);
+};
+
+#endif // !ACCESSHEATMAP_H
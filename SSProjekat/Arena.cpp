@@ -0,0 +1,49 @@
+#include "Arena.h"
+
+Arena::Arena(size_t blockSize) {
+	this->blockSize = blockSize;
+	bytes = 0;
+	count = 0;
+}
+
+Arena::~Arena() {
+	reset();
+}
+
+void* Arena::allocate(size_t size, size_t align) {
+	if (!blocks.empty()) {
+		Block& b = blocks.back();
+		size_t start = (b.used + align - 1) / align * align;
+		if (start + size <= b.size) {
+			b.used = start + size;
+			bytes += size;
+			count++;
+			return b.data + start;
+		}
+	}
+
+	//NEW BLOCK, big records get a block of their own
+	Block b;
+	b.size = size > blockSize ? size : blockSize;
+	b.data = static_cast<char*>(::operator new(b.size));
+	b.used = size;
+	blocks.push_back(b);
+	bytes += size;
+	count++;
+	return b.data;
+}
+
+void Arena::reset() {
+	//in reverse, later records may refer to earlier ones
+	for (size_t i = destructors.size(); i > 0; i--) {
+		destructors[i - 1].destroy(destructors[i - 1].object);
+	}
+	destructors.clear();
+
+	for (size_t i = 0; i < blocks.size(); i++) {
+		::operator delete(blocks[i].data);
+	}
+	blocks.clear();
+	bytes = 0;
+	count = 0;
+}
@@ -0,0 +1,64 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+//Bump allocator for metadata that lives as long as one compilation or one load.
+//Records made one after another end up next to each other, everything is freed at once.
+class Arena {
+private:
+	struct Block {
+		char* data;
+		size_t size;
+		size_t used;
+	};
+
+	struct Destructor {
+		void* object;
+		void (*destroy)(void*);
+	};
+
+	vector<Block> blocks;
+	vector<Destructor> destructors;
+	size_t blockSize;
+	size_t bytes;
+	size_t count;
+
+	void* allocate(size_t size, size_t align);
+
+	template<typename T>
+	static void destroy(void* object) {
+		static_cast<T*>(object)->~T();
+	}
+
+public:
+	Arena(size_t blockSize = 4096);
+	~Arena();
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	template<typename T, typename... Args>
+	T* make(Args&&... args) {
+		T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		if (!is_trivially_destructible<T>::value) {
+			Destructor d = { object, &destroy<T> };
+			destructors.push_back(d);
+		}
+		return object;
+	}
+
+	//destroys every object and releases the memory
+	void reset();
+
+	size_t getBytes() { return bytes; }
+	size_t getCount() { return count; }
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include "AssemblyCache.h"
+#include "Compiler.h"
+#include "MappedFile.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+AssemblyCache::AssemblyCache(string directory) : hits(0), misses(0) {
+	this->directory = directory;
+}
+
+//FNV-1a, 64 bit
+uint64_t AssemblyCache::hash(uint64_t h, const void* data, size_t size) {
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i < size; i++) {
+		h ^= p[i];
+		h *= 1099511628211ull;
+	}
+	return h;
+}
+
+//hash and size of everything the object depends on, the size makes an accidental collision even less likely
+string AssemblyCache::key(string_view source, int startAddress, int options) {
+	uint64_t h = 14695981039346656037ull;
+	h = hash(h, Compiler::VERSION, strlen(Compiler::VERSION) + 1);
+	h = hash(h, &startAddress, sizeof(startAddress));
+	h = hash(h, &options, sizeof(options));
+	h = hash(h, source.data(), source.size());
+
+	//FILES OF .incbin, the object holds their bytes
+	size_t pos = 0;
+	while ((pos = source.find(".incbin", pos)) != string_view::npos) {
+		pos += 7;
+		size_t end = source.find('\n', pos);
+		size_t open = source.find('"', pos);
+		size_t close = open == string_view::npos ? open : source.find('"', open + 1);
+		if (close == string_view::npos || close > end) continue;
+
+		string path(source.substr(open + 1, close - open - 1));
+		MappedFile binary;
+		binary.open(path);
+		h = hash(h, path.c_str(), path.size() + 1);
+		h = hash(h, binary.view().data(), binary.size());
+	}
+
+	char name[40];
+	snprintf(name, sizeof(name), "%016llx-%llx", (unsigned long long)h, (unsigned long long)source.size());
+	return name;
+}
+
+string AssemblyCache::keyOfFile(const string& path, int startAddress, int options) {
+	try {
+		MappedFile source;
+		source.open(path);
+		return key(source.view(), startAddress, options);
+	}
+	catch (runtime_error* e) {
+		delete e;
+		return "";
+	}
+}
+
+//two character subdirectories keep the directories small
+string AssemblyCache::entry(const string& key) {
+	return (fs::path(directory) / key.substr(0, 2) / (key + ".o")).string();
+}
+
+bool AssemblyCache::fetch(const string& key, const string& output) {
+	error_code ec;
+	string cached = entry(key);
+	if (!fs::exists(cached, ec)) {
+		misses++;
+		return false;
+	}
+
+	//a copy, not a link: any writer of the output (main.cpp opens it with ofstream) would write into the cache.
+	//The old output is removed first, it may still be a link made by an older build.
+	fs::remove(output, ec);
+	fs::copy_file(cached, output, fs::copy_options::overwrite_existing, ec);
+	if (ec) {
+		misses++;
+		return false;
+	}
+	hits++;
+	return true;
+}
+
+//copied under a temporary name and renamed, so readers never see half an object
+void AssemblyCache::store(const string& key, const string& output) {
+	error_code ec;
+	string cached = entry(key);
+	fs::create_directories(fs::path(cached).parent_path(), ec);
+
+	size_t unique = std::hash<thread::id>()(this_thread::get_id()) ^ (size_t)chrono::steady_clock::now().time_since_epoch().count();
+	string temp = cached + "." + to_string(unique) + ".tmp";
+	fs::copy_file(output, temp, fs::copy_options::overwrite_existing, ec);
+	if (!ec) fs::rename(temp, cached, ec);
+	if (ec) fs::remove(temp, ec);
+}
@@ -0,0 +1,45 @@
+#ifndef ASSEMBLYCACHE_H
+#define ASSEMBLYCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+//Object files on disk named by what they were made from: the source bytes, the files it includes,
+//the start address, the options that change the object and the assembler version. Safe to share between threads and processes.
+class AssemblyCache {
+private:
+	string directory;
+	atomic<int> hits;
+	atomic<int> misses;
+
+	static uint64_t hash(uint64_t h, const void* data, size_t size);
+	string entry(const string& key);
+
+public:
+	//options that change the object, or-ed into the key
+	enum Option { OPTIMIZED = 1, FIXED_ADDRESSES = 2 };
+
+	AssemblyCache(string directory);
+
+	AssemblyCache(const AssemblyCache&) = delete;
+	AssemblyCache& operator=(const AssemblyCache&) = delete;
+
+	//throws if a file of .incbin can not be read
+	static string key(string_view source, int startAddress, int options = 0);
+	//key of a source file, "" if it or a file it includes can not be read
+	static string keyOfFile(const string& path, int startAddress, int options = 0);
+
+	//copies the cached object to output, false on a miss
+	bool fetch(const string& key, const string& output);
+	//adds a freshly assembled object
+	void store(const string& key, const string& output);
+
+	int getHits() { return hits; }
+	int getMisses() { return misses; }
+};
+
+#endif
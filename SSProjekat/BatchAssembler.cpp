@@ -0,0 +1,115 @@
+#include "BatchAssembler.h"
+#include "Compiler.h"
+#include "ThreadPool.h"
+
+#include <cstdio>
+#include <fstream>
+
+BatchAssembler::BatchAssembler(int threads) {
+	this->threads = threads;
+	singlePass = false;
+	optimize = false;
+	fixedAddresses = false;
+	startAddress = 0;
+}
+
+void BatchAssembler::setSinglePass(bool singlePass) {
+	this->singlePass = singlePass;
+}
+
+void BatchAssembler::setOptimize(bool optimize) {
+	this->optimize = optimize;
+}
+
+void BatchAssembler::setFixedAddresses(bool fixedAddresses) {
+	this->fixedAddresses = fixedAddresses;
+}
+
+void BatchAssembler::setStartAddress(int startAddress) {
+	this->startAddress = startAddress;
+}
+
+void BatchAssembler::add(string input, string output) {
+	Job job;
+	job.input = input;
+	job.output = output;
+	job.ok = false;
+	job.cached = false;
+	jobs.push_back(job);
+}
+
+string BatchAssembler::outputFor(string input) {
+	size_t dot = input.find_last_of('.');
+	size_t slash = input.find_last_of("/\\");
+	if (dot == string::npos || (slash != string::npos && dot < slash)) return input + ".o";
+	return input.substr(0, dot) + ".o";
+}
+
+int BatchAssembler::run() {
+	{
+		ThreadPool pool(threads);
+		for (int i = 0; i < jobs.size(); i++) {
+			Job* job = &jobs[i];
+			pool.submit([this, job] { assemble(*job); });
+		}
+		pool.wait();
+	}
+
+	int failed = 0;
+	for (int i = 0; i < jobs.size(); i++) {
+		if (!jobs[i].ok) failed++;
+	}
+	return failed;
+}
+
+void BatchAssembler::setCache(string directory) {
+	cache.reset(new AssemblyCache(directory));
+}
+
+AssemblyCache* BatchAssembler::getCache() {
+	return cache.get();
+}
+
+vector<BatchAssembler::Job>& BatchAssembler::getJobs() {
+	return jobs;
+}
+
+//runs on a pool thread, writes only to its own job
+void BatchAssembler::assemble(Job& job) {
+	try {
+		string key = "";
+		if (cache) {
+			//the single pass mode never optimizes, its objects are the same as without the flag
+			int options = 0;
+			if (optimize && !singlePass) options |= AssemblyCache::OPTIMIZED;
+			if (fixedAddresses) options |= AssemblyCache::FIXED_ADDRESSES;
+			key = AssemblyCache::keyOfFile(job.input, startAddress, options);
+			if (key != "" && cache->fetch(key, job.output)) {
+				job.ok = true;
+				job.cached = true;
+				return;
+			}
+		}
+
+		//an output made by an older build may be a link into the cache, it must not be written through
+		remove(job.output.c_str());
+		ofstream outFile(job.output);
+		if (!outFile.is_open()) {
+			job.error = "ERROR: Can not open " + job.output;
+			return;
+		}
+
+		Compiler c;
+		c.setSinglePass(singlePass);
+		c.setOptimize(optimize);
+		c.setFixedAddresses(fixedAddresses);
+		job.ok = c.compileFile(job.input, outFile, startAddress);
+		outFile.close();
+		if (!job.ok) job.error = c.getError();
+		else if (key != "") cache->store(key, job.output);
+	}
+	catch (exception& e) {
+		job.ok = false;
+		job.error = e.what();
+	}
+}
@@ -0,0 +1,55 @@
+#ifndef BATCHASSEMBLER_H
+#define BATCHASSEMBLER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AssemblyCache.h"
+
+using namespace std;
+
+//Assembles many sources at once, every file gets its own Compiler on a pool thread.
+//Nothing is shared between the compilers, so each output is the same as from a single run.
+class BatchAssembler {
+public:
+	struct Job {
+		string input;
+		string output;
+		bool ok;
+		bool cached;	//taken from the cache, not assembled
+		string error;
+	};
+
+	//0 - one thread per hardware thread
+	BatchAssembler(int threads = 0);
+
+	void setSinglePass(bool singlePass);
+	void setOptimize(bool optimize);
+	void setFixedAddresses(bool fixedAddresses);
+	void setStartAddress(int startAddress);
+	//unchanged sources are taken from the cache in the directory
+	void setCache(string directory);
+	AssemblyCache* getCache();
+
+	void add(string input, string output);
+	//x.s -> x.o
+	static string outputFor(string input);
+
+	//number of files that failed, results are in getJobs in the order the files were added
+	int run();
+	vector<Job>& getJobs();
+
+private:
+	void assemble(Job& job);
+
+	int threads;
+	bool singlePass;
+	bool optimize;
+	bool fixedAddresses;
+	int startAddress;
+	vector<Job> jobs;
+	unique_ptr<AssemblyCache> cache;
+};
+
+#endif
@@ -0,0 +1,114 @@
+#include "CacheSimulator.h"
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+using namespace std;
+
+Cache::Cache(CacheConfig config) {
+	int lines = config.lineSize > 0 ? config.size / config.lineSize : 0;
+	if (config.lineSize <= 0 || (config.lineSize & (config.lineSize - 1)) != 0 || config.associativity <= 0 || lines == 0 || lines % config.associativity != 0) {
+		throw new runtime_error("ERROR: Invalid cache configuration");
+	}
+
+	this->config = config;
+	sets = lines / config.associativity;
+	tags = vector<int>(lines, -1);
+	lastUse = vector<long long>(lines, 0);
+	clock = 0;
+	hits = 0;
+	misses = 0;
+}
+
+bool Cache::access(int address) {
+	int line = address / config.lineSize;
+	int set = ((line % sets) + sets) % sets;
+	int first = set * config.associativity;
+	clock++;
+
+	int victim = first;
+	for (int i = first; i < first + config.associativity; i++) {
+		if (tags[i] == line) {
+			lastUse[i] = clock;
+			hits++;
+			return true;
+		}
+		if (lastUse[i] < lastUse[victim]) victim = i;
+	}
+
+	//MISS, empty ways have lastUse 0 so they go first
+	tags[victim] = line;
+	lastUse[victim] = clock;
+	misses++;
+	return false;
+}
+
+CacheSimulator::CacheSimulator(CacheConfig instructions, CacheConfig data, SymbolTable* symbols) : icache(instructions), dcache(data) {
+	vector<Symbol*> all = symbols->getSymbols();
+	//at the same address a label goes after its section so it is the one found, sections are numbered 1 to 4
+	vector<tuple<int, bool, string>> sorted;
+	for (int i = 0; i < all.size(); i++) {
+		if (all[i]->getSection() == "UND") continue;
+		sorted.push_back(make_tuple(all[i]->getOffset(), all[i]->getNumber() > 4, all[i]->getLabel()));
+	}
+	sort(sorted.begin(), sorted.end());
+
+	for (int i = 0; i < sorted.size(); i++) {
+		starts.push_back(get<0>(sorted[i]));
+		names.push_back(get<2>(sorted[i]));
+	}
+	lastSymbol = -1;
+	systemReads = 0;
+}
+
+int CacheSimulator::findSymbol(int address) {
+	//consecutive accesses mostly stay inside the same symbol
+	if (lastSymbol >= 0 && starts[lastSymbol] <= address && (lastSymbol + 1 == starts.size() || address < starts[lastSymbol + 1])) {
+		return lastSymbol;
+	}
+	int i = upper_bound(starts.begin(), starts.end(), address) - starts.begin() - 1;
+	if (i >= 0) lastSymbol = i;
+	return i;
+}
+
+void CacheSimulator::access(int address, AccessType type) {
+	if (type == SYSTEM) {
+		systemReads++;
+		return;
+	}
+
+	bool hit;
+	if (type == FETCH) hit = icache.access(address);
+	else hit = dcache.access(address);
+
+	int sym = findSymbol(address);
+	string name = sym >= 0 ? names[sym] : "?";
+	Stats& s = type == FETCH ? code[name] : data[name];
+	s.accesses++;
+	if (!hit) s.misses++;
+}
+
+void CacheSimulator::printCache(ofstream& out, string name, Cache& c) {
+	CacheConfig cfg = c.getConfig();
+	long long total = c.hits + c.misses;
+	out << name << " " << cfg.size << "B " << cfg.associativity << "-way " << cfg.lineSize << "B lines: "
+		<< total << " accesses, " << c.hits << " hits, " << c.misses << " misses, hit rate "
+		<< (total > 0 ? 100.0 * c.hits / total : 0) << "%" << endl;
+}
+
+void CacheSimulator::printStats(ofstream& out, string title, map<string, Stats>& stats) {
+	out << endl << title << "\t\t" << "accesses" << "\t\t" << "misses" << "\t\t" << "miss rate" << endl;
+	out << "--------------------------------------------------------------------------" << endl;
+	for (map<string, Stats>::iterator it = stats.begin(); it != stats.end(); it++) {
+		Stats s = it->second;
+		out << it->first << "\t\t" << s.accesses << "\t\t" << s.misses << "\t\t" << 100.0 * s.misses / s.accesses << "%" << endl;
+	}
+}
+
+void CacheSimulator::print(ofstream& out) {
+	printCache(out, "I-cache", icache);
+	printCache(out, "D-cache", dcache);
+	out << "Emulator reads (interrupt vector, page tables), not cached: " << systemReads << endl;
+	printStats(out, "Function", code);
+	printStats(out, "Data symbol", data);
+}
@@ -0,0 +1,75 @@
+#ifndef CACHESIMULATOR_H
+#define CACHESIMULATOR_H
+
+#include <vector>
+#include <map>
+#include <string>
+#include <fstream>
+
+#include "MemoryObserver.h"
+#include "SymbolTable.h"
+
+using namespace std;
+
+
+struct CacheConfig {
+	int size;			//bytes
+	int associativity;
+	int lineSize;		//bytes
+};
+
+
+//One set associative cache level with lru replacement, only hits and misses are counted
+class Cache {
+private:
+	CacheConfig config;
+	int sets;
+	vector<int> tags;			//sets * associativity, -1 - empty way
+	vector<long long> lastUse;
+	long long clock;
+
+public:
+	long long hits;
+	long long misses;
+
+	Cache(CacheConfig config);
+	~Cache() {}
+
+	bool access(int address);
+	CacheConfig getConfig() { return config; }
+};
+
+
+//Simulates separate L1 instruction and data caches and attributes every access
+//to the guest symbol it falls into (nearest symbol at or below the address).
+//Reads of the emulator itself do not go through the caches, they are only counted.
+class CacheSimulator : public MemoryObserver {
+private:
+	struct Stats {
+		long long accesses;
+		long long misses;
+	};
+
+	Cache icache;
+	Cache dcache;
+
+	vector<int> starts;			//sorted symbol addresses
+	vector<string> names;
+	int lastSymbol;
+	long long systemReads;
+	map<string, Stats> code;
+	map<string, Stats> data;
+
+	int findSymbol(int address);
+	void printCache(ofstream& out, string name, Cache& c);
+	void printStats(ofstream& out, string title, map<string, Stats>& stats);
+
+public:
+	CacheSimulator(CacheConfig instructions, CacheConfig data, SymbolTable* symbols);
+	~CacheSimulator() {}
+
+	void access(int address, AccessType type);
+	void print(ofstream& out);
+};
+
+#endif // !CACHESIMULATOR_H
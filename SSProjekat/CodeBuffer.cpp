@@ -0,0 +1,94 @@
+#include "CodeBuffer.h"
+#include "Encoder.h"
+
+#include <stdexcept>
+
+void CodeBuffer::checkRange(int value, int size) {
+	if (size != 1 && size != 2 && size != 4) throw new runtime_error("ERROR: Unexpected error");
+	if (size == 4) return;
+
+	long long max = (1LL << (8 * size)) - 1;
+	long long min = -(1LL << (8 * size - 1));
+	if (value > max || value < min) throw new runtime_error("ERROR: too big");
+}
+
+void CodeBuffer::reserve(int size) {
+	bytes.reserve(size);
+}
+
+int CodeBuffer::size() {
+	return bytes.size() + zeroFillBytes;
+}
+
+//position in bytes of a section offset
+int CodeBuffer::index(int offset) {
+	int skipped = 0;
+	for (int i = 0; i < zeroFill.size() && zeroFill[i].offset < offset; i++) {
+		if (offset < zeroFill[i].offset + zeroFill[i].length) throw new runtime_error("ERROR: Patch outside of the section");
+		skipped += zeroFill[i].length;
+	}
+	return offset - skipped;
+}
+
+void CodeBuffer::append(int value, int size) {
+	checkRange(value, size);
+	for (int i = 0; i < size; i++) {
+		bytes.push_back(Encoder::byte(value, i));
+	}
+}
+
+void CodeBuffer::appendWord(int value) {
+	append(value, 2);
+}
+
+void CodeBuffer::appendInstruction(uint16_t word) {
+	bytes.push_back(Encoder::byte(word, 1));
+	bytes.push_back(Encoder::byte(word, 0));
+}
+
+void CodeBuffer::appendZeros(int count) {
+	bytes.resize(bytes.size() + count, 0);
+}
+
+void CodeBuffer::appendBytes(string_view data) {
+	bytes.insert(bytes.end(), data.begin(), data.end());
+}
+
+void CodeBuffer::appendZeroFill(int count) {
+	if (count <= 0) return;
+	int offset = size();
+	if (!zeroFill.empty() && zeroFill.back().offset + zeroFill.back().length == offset) zeroFill.back().length += count;
+	else zeroFill.push_back(Extent{ offset, count });
+	zeroFillBytes += count;
+}
+
+void CodeBuffer::append(const CodeBuffer& other) {
+	int base = size();
+	for (int i = 0; i < other.zeroFill.size(); i++) {
+		const Extent& e = other.zeroFill[i];
+		if (!zeroFill.empty() && zeroFill.back().offset + zeroFill.back().length == base + e.offset) zeroFill.back().length += e.length;
+		else zeroFill.push_back(Extent{ base + e.offset, e.length });
+	}
+	zeroFillBytes += other.zeroFillBytes;
+	bytes.insert(bytes.end(), other.bytes.begin(), other.bytes.end());
+}
+
+void CodeBuffer::patch(int offset, int value, int size) {
+	checkRange(value, size);
+	if (offset < 0 || offset + size > this->size()) throw new runtime_error("ERROR: Patch outside of the section");
+	int at = index(offset);
+	if (index(offset + size - 1) != at + size - 1) throw new runtime_error("ERROR: Patch outside of the section");
+	for (int i = 0; i < size; i++) {
+		bytes[at + i] = Encoder::byte(value, i);
+	}
+}
+
+string CodeBuffer::toHex() {
+	static const char digits[] = "0123456789ABCDEF";
+	string hex(2 * bytes.size(), '0');
+	for (int i = 0; i < bytes.size(); i++) {
+		hex[2 * i] = digits[bytes[i] >> 4];
+		hex[2 * i + 1] = digits[bytes[i] & 0xF];
+	}
+	return hex;
+}
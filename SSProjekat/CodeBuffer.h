@@ -0,0 +1,51 @@
+#ifndef CODEBUFFER_H
+#define CODEBUFFER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+//generated code of one section, rendered as hex only when written out
+//zero fill extents are part of the section but not of the bytes, offsets always count them
+class CodeBuffer {
+public:
+	struct Extent {
+		int offset;
+		int length;
+	};
+
+private:
+	vector<uint8_t> bytes;
+	vector<Extent> zeroFill;	//sorted by offset
+	int zeroFillBytes;
+
+	static void checkRange(int value, int size);
+	int index(int offset);
+
+public:
+	CodeBuffer() : zeroFillBytes(0) {}
+	~CodeBuffer() {}
+
+	void reserve(int size);
+	int size();
+
+	void append(int value, int size); //little endian
+	void appendWord(int value);
+	void appendInstruction(uint16_t word); //instruction word is stored high byte first
+	void appendZeros(int count);
+	void appendBytes(string_view data);
+	//zeros the loader maps, nothing is stored for them
+	void appendZeroFill(int count);
+	void append(const CodeBuffer& other);
+	void patch(int offset, int value, int size);
+
+	string toHex(); //without the zero fill
+	const vector<uint8_t>& getBytes() { return bytes; } //without the zero fill
+	const vector<Extent>& getZeroFill() { return zeroFill; }
+
+};
+
+#endif
@@ -1,751 +1,1055 @@
 #include "Compiler.h"
 #include "UtilFunctions.h"
-#include "Instruction.h"
+#include "Lexer.h"
+#include "Encoder.h"
+#include "Isa.h"
+#include "Log.h"
+#include "Peephole.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <thread>
 
 #include <iostream>
 #include <sstream>
 
 using namespace std;
 
-map<string, regex> Compiler::regexMap = {
-	{"END", regex(".end")},
-	{"ANYTHING", regex("")},
-	{"LINEBREAK", regex("\\r")},
-	{"LABEL", regex("^([a-zA-Z_][a-zA-Z0-9]*):$") },
-	{"SECTION", regex("^\\.(text|data|bss|rodata)$")},
-	{"DIRECTIVE", regex("^\\.(char|word|long|skip|align)$")},
-	{"GLOBAL", regex("^\\.global$")},
-	{"INSTRUCTION", regex("^(eq|ne|gt|al)(add|sub|mul|div|cmp|and|or|not|test|push|pop|call|iret|mov|shl|shr|ret|jmp)$")},
-	{"ADDRESSING_SIGNS", regex("[\\&|\\*|\\[|\\$]")},
-
-
-	{ "NUMBER", regex("^([0-9]+)$")},
-	{ "ARITMETICAL", regex("^(eq|ne|gt|al)(add|sub|mul|div|and|or|not|shl|shr|mov)$")},
-	{ "LOGICAL", regex("^(eq|ne|gt|al)(cmp|test)$") },
-	{ "PUSHCALL", regex("^(eq|ne|gt|al)(call|push)$") },
-
-	{ "OPERAND_DEC", regex("^([0-9]+)$") },
-	{ "OPERAND_HEX", regex("^(0x[0-9abcdef]+)$") },
-	{ "OPERAND_REG", regex("^r([0-7])$") },
-	{ "OPERAND_REGSPEC", regex("^(pc|sp)$") },
-	{ "OPERAND_PSW", regex("^(psw)$")},
-	{ "OPERAND_SYMBOL", regex("^\\&([a-zA-Z_][a-zA-Z0-9]*)$") },
-	{ "OPERAND_MEMDIR", regex("^([a-zA-Z_][a-zA-Z0-9]*)$") },
-	{ "OPERAND_IMMADDR", regex("^\\*([0-9]+)$") },
-	{ "OPERAND_IMMADDRHEX", regex("^\\*(0x[0-9abcdef]+)$") },
-	{ "OPERAND_PCREL", regex("^\\$([a-zA-Z_][a-zA-Z0-9]*)$") },
-	{ "OPERAND_REGINDPOM", regex("^r([0-7])\\[") },
-};
-
 Compiler::Compiler() {
-	table = new SymbolTable();
-	relocationTable = new RelocationSymbolTable();
+	singlePass = false;
+	threads = 1;
+	optimize = false;
+	fixedAddresses = false;
+	report = 0;
+	reset();
+}
+
+//EVERYTHING OF THE LAST COMPILATION IS DROPPED, the settings stay
+void Compiler::reset() {
+	arena.reset();
+	table = arena.make<SymbolTable>();
+	relocationTable = arena.make<RelocationSymbolTable>();
 	currentSection = "";
 	locationCounter = 0;
 	startOfCurSec = 0;
 	number = 5;
+	lines = 0;
+	error = "";
+	errorLine = 0;
+	stream = 0;
+
+	input.close();
+	buffer.clear();
+	blocks.clear();
+	binaries.clear();
+	readError = "";
+	words.clear();
+	sections.clear();
+	statements.clear();
+	fixups.clear();
+	pending = Chunk();
 
 	generatedCode = {
-		{".text", ""},
-		{".data", ""},
-		{".rodata", ""}
+		{".text", CodeBuffer()},
+		{".data", CodeBuffer()},
+		{".rodata", CodeBuffer()}
 	};
 }
 
 Compiler::~Compiler() {
-	delete table;
 }
 
 
-void Compiler::compile(ifstream &inFile, ofstream &outFile, int startAddress) {
-	try{
-		startOfCurSec = startAddress;
-		firstRun(inFile);
+bool Compiler::compile(ifstream &inFile, ofstream &outFile, int startAddress) {
+	{
+		PhaseReport::Scope reading(report, PhaseReport::READING);
+		buffer.assign(istreambuf_iterator<char>(inFile), istreambuf_iterator<char>());
+	}
+	return run(buffer, outFile, startAddress);
+}
 
-		inFile.clear();
-		inFile.seekg(0, ios::beg);
-		secondRun(inFile);
+//the pages are read when the first run touches them, reading is only the mapping
+bool Compiler::compileFile(const string& path, ofstream &outFile, int startAddress) {
+	try {
+		PhaseReport::Scope reading(report, PhaseReport::READING);
+		input.open(path);
+	}
+	catch (runtime_error* e) {
+		error = e->what();
+		delete e;
+		return false;
+	}
+	return run(input.view(), outFile, startAddress);
+}
 
-		writeToFile(outFile);
+bool Compiler::compileStream(istream &in, ofstream &outFile, int startAddress) {
+	singlePass = true;
+	stream = &in;
+	return run(string_view(), outFile, startAddress);
+}
 
+bool Compiler::run(string_view source, ofstream &outFile, int startAddress) {
+	try{
+		build(source, startAddress);
+		{
+			PhaseReport::Scope writing(report, PhaseReport::WRITING);
+			writeToFile(outFile);
+		}
+		fillReport();
+		return true;
+	}
+	catch (runtime_error* e) {
+		error = e->what();
+		delete e;
 	}
 	catch (exception &e) {
-		cout << e.what() << endl;
+		error = e.what();
 	}
+	return false;
 }
 
-void Compiler::firstRun(ifstream &inFile) {
-	string line;
-	while (getline(inFile, line)) {
-		vector<string> words = UtilFunctions::split(line);
+ObjectModule Compiler::assemble(string_view source, int startAddress) {
+	reset();
+	ObjectModule object;
+	try {
+		build(source, startAddress);
+		{
+			PhaseReport::Scope writing(report, PhaseReport::WRITING);
+			toObject(object);
+		}
+		fillReport();
+	}
+	catch (runtime_error* e) {
+		error = e->what();
+		delete e;
+	}
+	catch (exception &e) {
+		error = e.what();
+	}
+	if (error != "") object.getDiagnostics().push_back(Diagnostic(errorLine, error));
+	return object;
+}
 
-		for (vector<string>::size_type i = 0; i < words.size(); i++) {
+//BOTH RUNS, the code and the tables are ready to be written afterwards
+void Compiler::build(string_view source, int startAddress) {
+	startOfCurSec = startAddress;
+	{
+		PhaseReport::Scope passOne(report, PhaseReport::PASS_ONE);
+		if (stream != 0) pipeline(*stream);
+		else firstRun(source);
+	}
+	if (singlePass) {
+		{
+			PhaseReport::Scope passTwo(report, PhaseReport::PASS_TWO);
+			merge(pending);
+		}
+		PhaseReport::Scope relocations(report, PhaseReport::RELOCATIONS);
+		resolveFixups();
+	}
+	else {
+		if (optimize) {
+			PhaseReport::Scope optimizing(report, PhaseReport::PEEPHOLE);
+			peephole();
+		}
+		PhaseReport::Scope passTwo(report, PhaseReport::PASS_TWO);
+		secondRun();
+	}
+}
+
+string Compiler::getError() {
+	return error;
+}
+
+void Compiler::setSinglePass(bool singlePass) {
+	this->singlePass = singlePass;
+}
+
+void Compiler::setThreads(int threads) {
+	this->threads = threads;
+}
+
+void Compiler::setOptimize(bool optimize) {
+	this->optimize = optimize;
+}
+
+void Compiler::setFixedAddresses(bool fixedAddresses) {
+	this->fixedAddresses = fixedAddresses;
+}
 
-			if (words[i] == "\n" || words[i] == "\r")break; //if end of line
-			else if (words[i] == " ") continue; //if there are more than one spaces
-			else if (words[i] == ".end") {
-				//SAVE THE LAST SECTION
-				Section* s = new Section(currentSection, startOfCurSec, locationCounter);
-				sections.push_back(*s);
-				return;
+void Compiler::setReport(PhaseReport* report) {
+	this->report = report;
+}
+
+void Compiler::fillReport() {
+	if (report == 0) return;
+	if (stream != 0) report->setMode("streaming");
+	else report->setMode(singlePass ? "single pass" : "two pass");
+	report->setLines(lines);
+	report->setSymbols(table->size());
+	report->setRelocations(relocationTable->size());
+	report->setArena(arena.getBytes(), arena.getCount());
+}
+
+void Compiler::firstRun(string_view source) {
+	int lineNumber = 0;
+	size_t pos = 0;
+	bool end = false;
+	while (!end && pos < source.size()) {
+		errorLine = ++lineNumber;
+		end = readLine(nextLine(source, pos), lineNumber);
+		if (singlePass) {
+			PhaseReport::Scope passTwo(report, PhaseReport::PASS_TWO);
+			encodePending();
+		}
+	}
+	errorLine = 0;
+	if (!end) endOfSource();
+}
+
+//next line without the line end, pos moves to the line after it
+string_view Compiler::nextLine(string_view source, size_t& pos) {
+	size_t end = source.find('\n', pos);
+	if (end == string_view::npos) end = source.size();
+	string_view line = source.substr(pos, end - pos);
+	pos = end + 1;
+	if (line.size() > 0 && line.back() == '\r') line.remove_suffix(1); //CRLF files
+	return line;
+}
+
+//reader -> tokenizer (first run) -> encoder, the encoder is the calling thread
+//the tokenizer owns the symbol table, the encoder only makes fixups until .end
+void Compiler::pipeline(istream& in) {
+	SpscQueue<SourceBlock> sourceBlocks(PIPELINE_DEPTH);
+	SpscQueue<StatementBatch> batches(PIPELINE_DEPTH);
+	thread reader(&Compiler::readStage, this, ref(in), ref(sourceBlocks));
+	thread tokenizer(&Compiler::tokenizeStage, this, ref(sourceBlocks), ref(batches));
+
+	string error = "";
+	StatementBatch batch;
+	try {
+		while (batches.pop(batch)) {
+			for (int s = 0; s < batch.statements.size(); s++) {
+				if (batch.statements[s].type == Lexer::SECTION) merge(pending);
+				encode(pending, batch.statements[s]);
 			}
+			if (batch.last) {
+				error = batch.error;
+				break;
+			}
+		}
+	}
+	catch (runtime_error* e) {
+		error = e->what();
+		delete e;
+	}
+	catch (exception& e) {
+		error = e.what();
+	}
 
-			else if (regex_search(words[i], regexMap["SECTION"])) {
-				string labelName = words[i];
+	//an encoder that stopped early stops the other stages too
+	batches.cancel();
+	sourceBlocks.cancel();
+	tokenizer.join();
+	reader.join();
 
-				Symbol* sym = table->get(labelName);
-				if (sym != 0) throw new runtime_error("ERROR: Section can't be defined more than once!");
+	if (error == "") error = readError;
+	if (error != "") throw new runtime_error(error);
+}
 
-				//SAVE THE CURRENT SECTION
-				if (currentSection != "") {
-					Section* s = new Section(currentSection, startOfCurSec, locationCounter);
-					sections.push_back(*s);
-				}
+//position after the last line end in data[from, to), from if there is none
+static size_t lineEnd(const char* data, size_t from, size_t to) {
+	for (size_t i = to; i > from; i--) {
+		if (data[i - 1] == '\n') return i;
+	}
+	return from;
+}
+
+char* Compiler::newBlock(size_t size) {
+	blocks.push_back(unique_ptr<char[]>(new char[size]));
+	return blocks.back().get();
+}
+
+//takes whatever the stream has and passes whole lines on before it waits for more,
+//blocks are never moved, the statements point into them
+void Compiler::readStage(istream& in, SpscQueue<SourceBlock>& out) {
+	SourceBlock last;
+	last.last = true;
+	try {
+		streambuf* sb = in.rdbuf();
+		size_t size = PIPELINE_BLOCK;
+		char* data = newBlock(size);
+		size_t used = 0;
+		size_t sent = 0;
+
+		while (true) {
+			//FULL, the unfinished line moves to a new block
+			if (used == size) {
+				size_t end = lineEnd(data, sent, used);
+				if (end > sent && !out.push(SourceBlock{ string_view(data + sent, end - sent) })) return;
+				size_t rest = used - end;
+				size = max(PIPELINE_BLOCK, 2 * rest);
+				char* next = newBlock(size);
+				memcpy(next, data + end, rest);
+				data = next;
+				used = rest;
+				sent = 0;
+			}
 
-				//NEW SECTION
-				currentSection = labelName;
-				Symbol* newSym = new Symbol(labelName, currentSection, locationCounter, "local", UtilFunctions::getSectionNumber(labelName));
-				table->put(labelName, newSym);
-				startOfCurSec += locationCounter;
-				locationCounter = 0;
+			streamsize avail = sb->in_avail();
+			if (avail > 0) {
+				used += sb->sgetn(data + used, min((size_t)avail, size - used));
 				continue;
 			}
 
-			else if (regex_search(words[i], regexMap["LABEL"])) {
-				string labelName = words[i].substr(0, words[i].size() - 1);
+			//NOTHING IS WAITING, the tokenizer gets what is complete
+			size_t end = lineEnd(data, sent, used);
+			if (end > sent) {
+				if (!out.push(SourceBlock{ string_view(data + sent, end - sent) })) return;
+				sent = end;
+			}
 
-				Symbol* sym = table->get(labelName);
-				if (sym != 0) {
-					if (sym->getLocGlo() == "local") throw new runtime_error("ERROR: There can't be two or more symbols with the same name!");
-					else {
-						sym->setOffset(locationCounter);
-						sym->setSection(currentSection);
-						sym->setNumber(number);
-						sym->setLocGlo("global");
-					}
-				}
+			int c = sb->sbumpc();
+			if (c == char_traits<char>::eof()) break;
+			data[used++] = (char)c;
+		}
+
+		last.text = string_view(data + sent, used - sent);
+	}
+	catch (exception& e) {
+		readError = e.what();
+	}
+	out.push(last);
+}
+
+//first run of the streaming mode, a batch per block
+void Compiler::tokenizeStage(SpscQueue<SourceBlock>& in, SpscQueue<StatementBatch>& out) {
+	int lineNumber = 0;
+	bool ended = false;
+	SourceBlock block;
+	StatementBatch batch;
+
+	while (!ended) {
+		if (!in.pop(block)) {
+			endOfSource();
+			ended = true;
+		}
+
+		size_t pos = 0;
+		size_t lineStart = 0;
+		try {
+			while (!ended && pos < block.text.size()) {
+				lineStart = statements.size();
+				ended = readLine(nextLine(block.text, pos), ++lineNumber);
+			}
+			if (block.last && !ended) {
+				endOfSource();
+				ended = true;
+			}
+		}
+		//statements of the bad line are not encoded, same as in the single pass mode
+		catch (runtime_error* e) {
+			batch.error = e->what();
+			delete e;
+		}
+		catch (exception& e) {
+			batch.error = e.what();
+		}
+		if (batch.error != "") {
+			statements.erase(statements.begin() + lineStart, statements.end());
+			ended = true;
+		}
+
+		batch.statements = move(statements);
+		statements.clear();
+		batch.last = ended;
+		if (!out.push(move(batch))) break;
+		batch = StatementBatch();
+	}
+
+	//the rest of the stream after .end is not needed
+	in.cancel();
+}
+
+//the source ended without .end
+void Compiler::endOfSource() {
+	//SAVE THE LAST SECTION
+	sections.push_back(Section(currentSection, 0, locationCounter));
+}
+
+//FIRST RUN OF ONE LINE, true at .end
+bool Compiler::readLine(string_view line, int lineNumber) {
+	lines = lineNumber;
+	{
+		//the tokenizer of the streaming mode has its own thread, its lines are counted in pass one
+		PhaseReport::Scope tokenizing(stream == 0 ? report : 0, PhaseReport::TOKENIZING);
+		UtilFunctions::split(line, words);
+	}
+
+	for (size_t i = 0; i < words.size(); i++) {
+
+		if (words[i] == "\n" || words[i] == "\r")break; //if end of line
+		else if (words[i] == " ") continue; //if there are more than one spaces
+		else if (words[i] == ".end") {
+			//SAVE THE LAST SECTION
+			sections.push_back(Section(currentSection, startOfCurSec, locationCounter));
+			statements.push_back(Statement(Lexer::END, words[i], lineNumber));
+			return true;
+		}
+
+		Lexer::TokenType type = Lexer::classify(words[i]);
+		if (type == Lexer::SECTION) {
+			string_view labelName = words[i];
+			statements.push_back(Statement(Lexer::SECTION, labelName, lineNumber));
+
+			Symbol* sym = table->get(labelName);
+			if (sym != 0) throw new runtime_error("ERROR: Section can't be defined more than once!");
+
+			//SAVE THE CURRENT SECTION
+			if (currentSection != "") {
+				sections.push_back(Section(currentSection, startOfCurSec, locationCounter));
+			}
+
+			//NEW SECTION
+			currentSection = labelName;
+			table->put(Symbol(string(labelName), currentSection, locationCounter, "local", UtilFunctions::getSectionNumber(labelName)));
+			startOfCurSec += locationCounter;
+			locationCounter = 0;
+			continue;
+		}
+
+		else if (type == Lexer::LABEL) {
+			string_view labelName = words[i].substr(0, words[i].size() - 1);
+			statements.push_back(Statement(Lexer::LABEL, labelName, lineNumber));
+
+			Symbol* sym = table->get(labelName);
+			if (sym != 0) {
+				if (sym->getLocGlo() == "local") throw new runtime_error("ERROR: There can't be two or more symbols with the same name!");
 				else {
-					Symbol* newSym = new Symbol(labelName, currentSection, locationCounter, "local", number);
-					number++;
-					table->put(labelName, newSym);
+					//it keeps the number .global gave it, number belongs to the next new symbol
+					sym->setOffset(locationCounter);
+					sym->setSection(currentSection);
+					sym->setLocGlo("global");
 				}
-				continue;
 			}
+			else {
+				table->put(Symbol(string(labelName), currentSection, locationCounter, "local", number));
+				number++;
+			}
+			continue;
+		}
 
-			else if (regex_search(words[i], regexMap["DIRECTIVE"])) {
-				string name = words[i];
-				if (name == ".skip" || name == ".align") {
-					i++;
-					int k=0;
-					try {
-						k = stoi(words[i]);
-					}
-					catch (exception e) {
-						throw new runtime_error("ERROR: Invalid argument for directives .skip or .align!");
-					}
-					if (name == ".skip") locationCounter += k;
-					else if (name == ".align") {
-						if (k == 0) continue;
-						if ((k & (k - 1)) == 0) {
-							if (locationCounter / k * k != locationCounter) locationCounter = (locationCounter / k + 1) * k;
-						}
-						else throw new runtime_error("ERROR: Invalid argument for .skip directive, argument must be a power of 2");
-					}
+		else if (type == Lexer::DIRECTIVE) {
+			string_view name = words[i];
+			Statement st(Lexer::DIRECTIVE, name, lineNumber);
+			st.offset = locationCounter;
+			st.operands.reserve(words.size() - i - 1);
+			for (size_t k = i + 1; k < words.size(); k++) st.operands.push_back(Operand(words[k], Lexer::NOT_FOUND));
+			if (name == ".incbin") st.data = includeBinary(st);
+			statements.push_back(st);
+
+			if (name == ".skip" || name == ".align") {
+				i++;
+				int k=0;
+				try {
+					k = UtilFunctions::toInt(words.at(i));
 				}
-				else if (name == ".char" || name == ".word" || name == ".long") {
-					int size = UtilFunctions::getDirectiveSize(name);
-					int k =words.size() - i - 1;
-					locationCounter += k * size;
+				catch (exception e) {
+					throw new runtime_error("ERROR: Invalid argument for directives .skip or .align!");
 				}
-				break;
+				if (name == ".skip") locationCounter += k;
+				else if (name == ".align") {
+					if (k == 0) continue;
+					if ((k & (k - 1)) == 0) {
+						if (locationCounter / k * k != locationCounter) locationCounter = (locationCounter / k + 1) * k;
+					}
+					else throw new runtime_error("ERROR: Invalid argument for .skip directive, argument must be a power of 2");
+				}
+			}
+			else if (name == ".char" || name == ".word" || name == ".long") {
+				int size = UtilFunctions::getDirectiveSize(name);
+				int k =words.size() - i - 1;
+				locationCounter += k * size;
 			}
+			else if (name == ".incbin") locationCounter += st.data.size();
+			break;
+		}
 
-			else if (regex_search(words[i], regexMap["GLOBAL"])) {
-				for (int k = i + 1; k < words.size(); k++) {
-					string labelName = words[k];
-					Symbol* sym = table->get(labelName);
+		else if (type == Lexer::GLOBAL) {
+			Statement st(Lexer::GLOBAL, words[i], lineNumber);
+			st.operands.reserve(words.size() - i - 1);
+			for (size_t k = i + 1; k < words.size(); k++) st.operands.push_back(Operand(words[k], Lexer::NOT_FOUND));
+			statements.push_back(st);
 
-					if (sym != 0) sym->setLocGlo("global");
-					else {
-						sym = new Symbol(labelName, "UND", locationCounter, "global", number);
-						number++;
-						table->put(labelName, sym);
-					}
+			for (size_t k = i + 1; k < words.size(); k++) {
+				string_view labelName = words[k];
+				Symbol* sym = table->get(labelName);
 
+				if (sym != 0) sym->setLocGlo("global");
+				else {
+					table->put(Symbol(string(labelName), "UND", locationCounter, "global", number));
+					number++;
 				}
+
 			}
+		}
 
-			else if (regex_search(words[i], regexMap["INSTRUCTION"])) {
-				locationCounter += 2;
-				
-				for (int k = i + 1; k < words.size(); k++) {
-					string adr = findAddressing(words[k]);
-					if (adr != "regDir" && adr !="regDirSpec" && adr!="psw" && adr!="not found") {
-						locationCounter += 2;
-						break;
-					}
-				}
-				break;
+		else if (type == Lexer::INSTRUCTION) {
+			Statement st(Lexer::INSTRUCTION, words[i], lineNumber);
+			st.offset = locationCounter;
+
+			st.operands.reserve(words.size() - i - 1);
+			for (size_t k = i + 1; k < words.size(); k++) {
+				st.operands.push_back(Operand(words[k], Lexer::classifyOperand(words[k])));
 			}
+			locationCounter = locationAfter(st, locationCounter);
+			statements.push_back(st);
+			break;
+		}
+
+		else continue;
+	}
+	return false;
+}
+
+void Compiler::peephole() {
+	Peephole p(statements, table, arena);
+	if (p.run() == 0) return;
 
-			else continue;
+	LOG_DEBUG("Peephole removed " << p.getRemoved() << ", folded " << p.getFolded() << " and shortened " << p.getShortened() << " instructions");
+	relayout();
+}
+
+//OFFSETS AFTER THE PEEPHOLE PASS, the first run checked every statement already
+void Compiler::relayout() {
+	map<string, int> lengths;
+	string section = "";
+	int counter = 0;
+	for (int s = 0; s < statements.size(); s++) {
+		Statement& st = statements[s];
+		if (st.type == Lexer::END) break;
+
+		if (st.type == Lexer::SECTION) {
+			if (section != "") lengths[section] = counter;
+			table->get(st.name)->setOffset(counter); //same as the first run, the length of the section before
+			section = st.name;
+			counter = 0;
+		}
+		else if (st.type == Lexer::LABEL) {
+			Symbol* sym = table->get(st.name);
+			if (sym != 0 && sym->getSection() == section) sym->setOffset(counter);
 		}
+		else if (st.type == Lexer::INSTRUCTION || st.type == Lexer::DIRECTIVE) {
+			st.offset = counter;
+			counter = locationAfter(st, counter);
+		}
+	}
+	lengths[section] = counter;
 
+	//a source without .end leaves its last section at 0
+	bool ended = !statements.empty() && statements.back().type == Lexer::END;
+	for (int i = 0; i < sections.size(); i++) {
+		if (i > 0 && (ended || i + 1 < sections.size())) sections[i].setStart(sections[i - 1].getStart() + sections[i - 1].getLength());
+		sections[i].setLength(lengths[sections[i].getName()]);
 	}
-	//SAVE THE LAST SECTION
-	Section* s = new Section(currentSection, 0, locationCounter);
-	sections.push_back(*s);
 }
 
-void Compiler::secondRun(ifstream &inFile) {
-	cout << "Second run begins" << endl << endl;
-	string line;
-	currentSection = "";
-	locationCounter = 0;
+//location counter after the statement
+int Compiler::locationAfter(Statement& st, int counter) {
+	if (st.type == Lexer::INSTRUCTION) {
+		counter += 2;
+		for (int k = 0; k < st.operands.size(); k++) {
+			Lexer::OperandType adr = st.operands[k].type;
+			if (adr != Lexer::REG_DIR && adr != Lexer::REG_DIR_SPEC && adr != Lexer::PSW && adr != Lexer::NOT_FOUND) return counter + 2;
+		}
+		return counter;
+	}
+
+	if (st.type != Lexer::DIRECTIVE) return counter;
+	if (st.name == ".skip" || st.name == ".align") {
+		int k = UtilFunctions::toInt(st.operands.at(0).text);
+		if (st.name == ".skip") return counter + k;
+		if (k != 0 && counter / k * k != counter) counter = (counter / k + 1) * k;
+		return counter;
+	}
+	if (st.name == ".char" || st.name == ".word" || st.name == ".long") {
+		return counter + st.operands.size() * UtilFunctions::getDirectiveSize(st.name);
+	}
+	if (st.name == ".incbin") return counter + st.data.size();
+	return counter;
+}
+
+//offset or length of .incbin in decimal or hex, the whole word must be the number
+long long Compiler::includeArgument(string_view text) {
+	int base = 10;
+	if (Lexer::isHex(text)) {
+		text.remove_prefix(2);
+		base = 16;
+	}
+	else if (!Lexer::isDecimal(text)) throw new runtime_error("ERROR: Invalid argument for directive .incbin!");
+
+	long long value = 0;
+	from_chars_result r = from_chars(text.data(), text.data() + text.size(), value, base);
+	if (r.ec != errc() || r.ptr != text.data() + text.size()) throw new runtime_error("ERROR: Invalid argument for directive .incbin!");
+	return value;
+}
+
+//.incbin "file"[, offset, length], the file stays mapped until the compiler is destroyed
+string_view Compiler::includeBinary(Statement& st) {
+	if (st.operands.empty() || st.operands[0].text.size() < 2 || st.operands[0].text.front() != '"' || st.operands[0].text.back() != '"' || st.operands.size() > 3) {
+		throw new runtime_error("ERROR: Directive .incbin expects \"file\"[, offset, length]!");
+	}
+	string path(st.operands[0].text.substr(1, st.operands[0].text.size() - 2));
+
+	binaries.push_back(unique_ptr<MappedFile>(new MappedFile()));
+	binaries.back()->open(path);
+	string_view bytes = binaries.back()->view();
+
+	long long offset = 0;
+	long long length = 0;
+	if (st.operands.size() > 1) offset = includeArgument(st.operands[1].text);
+	length = st.operands.size() > 2 ? includeArgument(st.operands[2].text) : (long long)bytes.size() - offset;
+	if (offset < 0 || length < 0 || offset + length > (long long)bytes.size()) {
+		throw new runtime_error("ERROR: Directive .incbin reads past the end of " + path);
+	}
+
+	LOG_DEBUG("Included " << length << " bytes of " << path);
+	return bytes.substr(offset, length);
+}
+
+void Compiler::secondRun() {
+	LOG_DEBUG("Second run begins");
 	number = 5;
 
-	while (getline(inFile, line)) {
-		cout << endl << "Next line is: " << line << endl;
-		vector<string> words = UtilFunctions::split(line);
-		for (vector<string>::size_type i = 0; i < words.size(); i++) {
-			if (regex_search(words[i], regexMap["INSTRUCTION"])) {
+	for (int i = 0; i < sections.size(); i++) {
+		if (sections[i].getName() != "") generatedCode[sections[i].getName()].reserve(sections[i].getLength());
+	}
 
-				if (currentSection != ".text") {
-					throw new runtime_error("ERROR: Instructions must be in .text section");
-					return;
-				}
+	//SPLIT AT EVERY SECTION, AND INSIDE BIG SECTIONS WHEN THERE ARE THREADS FOR THEM
+	//offsets from the first run tell where a chunk in the middle of a section starts
+	vector<Chunk> chunks(1);
+	string section = "";
+	for (int s = 0; s < statements.size(); s++) {
+		Statement& st = statements[s];
+		bool split = st.type == Lexer::SECTION;
+		if (threads > 1 && s - chunks.back().first >= CHUNK_STATEMENTS) {
+			split = split || st.type == Lexer::INSTRUCTION || st.type == Lexer::DIRECTIVE;
+		}
 
-				else if (regex_search(words[i], regexMap["ARITMETICAL"])) { //add, sub, mul, div, and, or, not, shl, shr, mov
-					if (words.size() < 3) {
-						throw new runtime_error("ERROR: Wrong number of arguments for aritmetical operation");
-					}
-	
-					string operation = "ARITMETICAL";
-					string op1 = words[i + 1];
-					string op2 = words[i + 2];
-					string src = "";
-					string dst = "";
-					bool flag1 = false;
-					bool flag2 = false;
-					string value = "";
+		if (split && s > chunks.back().first) {
+			chunks.back().last = s;
+			chunks.push_back(Chunk());
+			chunks.back().first = s;
+			chunks.back().section = section;
+			chunks.back().counter = st.offset;
+			chunks.back().start = st.offset;
+		}
+		if (st.type == Lexer::SECTION) section = st.name;
+	}
+	chunks.back().last = statements.size();
 
-					process_first_operand(&operation, &op1, &src, &flag1, &value);
-					process_second_operand(&operation, &op2, &dst, &flag2, &value);
+	if (threads > 1 && chunks.size() > 1) {
+		ThreadPool pool(threads);
+		for (int i = 0; i < chunks.size(); i++) {
+			Chunk* c = &chunks[i];
+			pool.submit([this, c] { encodeChunk(*c); });
+		}
+		pool.wait();
+	}
+	else {
+		for (int i = 0; i < chunks.size(); i++) {
+			encodeChunk(chunks[i]);
+			if (chunks[i].error != "") break;
+		}
+	}
 
-					if (flag1 == true && flag2 == true)throw new runtime_error("ERROR: Only one operand can request aditional bytes to store data");
+	//MERGE IN SOURCE ORDER, relocations of a section stay sorted by address
+	for (int i = 0; i < chunks.size(); i++) {
+		Chunk& c = chunks[i];
+		if (c.error != "") {
+			errorLine = c.errorLine;
+			throw new runtime_error(c.error);
+		}
+		if (i + 1 < chunks.size() && chunks[i + 1].section == c.section && chunks[i + 1].start != c.counter) {
+			throw new runtime_error("ERROR: Size of a statement in " + c.section + " differs between the runs");
+		}
+		merge(c);
+	}
+}
 
-					string code = UtilFunctions::binaryToHexa(Instruction::instructions[words[i]]->getOpcode() + src + dst);
-					generatedCode[currentSection] = generatedCode[currentSection] + code + value;
+//the first error stays in the chunk, the rest of the chunk is not encoded
+void Compiler::encodeChunk(Chunk& c) {
+	int s = c.first;
+	try {
+		for (; s < c.last; s++) encode(c, statements[s]);
+	}
+	catch (runtime_error* e) {
+		c.error = e->what();
+		delete e;
+	}
+	catch (exception& e) {
+		c.error = e.what();
+	}
+	if (c.error != "") c.errorLine = statements[s].line;
+}
 
-					locationCounter += 2;
-					if (flag1 == true || flag2 == true)locationCounter += 2;
+void Compiler::merge(Chunk& c) {
+	generatedCode[c.section].append(c.code);
+	PhaseReport::Scope relocations(report, PhaseReport::RELOCATIONS);
+	for (int i = 0; i < c.relocations.size(); i++) {
+		relocationTable->put(c.section, c.relocations[i]);
+	}
+	c.start += c.code.size();
+	c.code = CodeBuffer();
+	c.relocations.clear();
+}
 
-					break;
-				}
+//ENCODE THE STATEMENTS OF THE LAST LINE AND DROP THEM
+void Compiler::encodePending() {
+	for (int s = 0; s < statements.size(); s++) {
+		if (statements[s].type == Lexer::SECTION) merge(pending);
+		encode(pending, statements[s]);
+	}
+	statements.clear();
+}
 
-				else if (regex_search(words[i], regexMap["LOGICAL"])) {	//cmp, tst
-					if (words.size() < 3) {
-						throw new runtime_error("ERROR: Wrong number of arguments for aritmetical operation");
-					}
+void Compiler::encode(Chunk& c, Statement& st) {
+	LOG_TRACE("Next statement is: " << st.name << " on line " << st.line);
 
-					string operation = "LOGICAL";
-					string op1 = words[i + 1];
-					string op2 = words[i + 2];
-					string src = "";
-					string dst = "";
-					bool flag1 = false;
-					bool flag2 = false;
-					string value = "";
+	if (st.type == Lexer::INSTRUCTION) {
+		Lexer::InstructionGroup group = Lexer::instructionGroup(st.name);
 
-					process_first_operand(&operation, &op1, &src, &flag1, &value);
-					process_second_operand(&operation, &op2, &dst, &flag2, &value);
+		if (c.section != ".text") {
+			throw new runtime_error("ERROR: Instructions must be in .text section");
+			return;
+		}
 
-					if (flag1 == true && flag2 == true)throw new runtime_error("ERROR: Only one operand can request aditional bytes to store data");
+		else if (group == Lexer::ARITMETICAL || group == Lexer::LOGICAL) { //add, sub, mul, div, and, or, not, shl, shr, mov, cmp, test
+			if (st.operands.size() < 2) {
+				throw new runtime_error("ERROR: Wrong number of arguments for aritmetical operation");
+			}
 
-					string code = UtilFunctions::binaryToHexa(Instruction::instructions[words[i]]->getOpcode() + src + dst);
-					generatedCode[currentSection] = generatedCode[currentSection] + code + value;
+			uint8_t src = 0;
+			uint8_t dst = 0;
+			bool flag1 = false;
+			bool flag2 = false;
+			int value = 0;
 
-					locationCounter += 2;
-					if (flag1 == true || flag2 == true)locationCounter += 2;
+			process_first_operand(c, group, &st.operands[0], &src, &flag1, &value);
+			process_second_operand(c, group, &st.operands[1], &dst, &flag2, &value);
 
-					break;
-				}
+			if (flag1 == true && flag2 == true)throw new runtime_error("ERROR: Only one operand can request aditional bytes to store data");
 
-				else if (regex_search(words[i], regexMap["PUSHCALL"])) {
-					if (words.size() < 2) {
-						throw new runtime_error("ERROR: Wrong number of arguments for aritmetical operation");
-					}
+			c.code.appendInstruction(Encoder::instruction(Isa::opcode(st.name), src, dst));
+			if (flag1 == true || flag2 == true) c.code.appendWord(value);
 
-					string operation = "PUSHCALL";
-					string op1 = words[i + 1];
-					string src = "";
-					bool flag1 = false;
-					string value = "";
+			c.counter += 2;
+			if (flag1 == true || flag2 == true)c.counter += 2;
+		}
 
-					process_first_operand(&operation, &op1, &src, &flag1, &value);
-					string code = UtilFunctions::binaryToHexa(Instruction::instructions[words[i]]->getOpcode() + "00000" + src);
-					generatedCode[currentSection] = generatedCode[currentSection] + code + value;
+		else if (group == Lexer::PUSHCALL) {
+			if (st.operands.size() < 1) {
+				throw new runtime_error("ERROR: Wrong number of arguments for aritmetical operation");
+			}
 
-					locationCounter += 2;
-					if (flag1 == true)locationCounter += 2;
+			uint8_t src = 0;
+			bool flag1 = false;
+			int value = 0;
 
-					break;
-				}
+			process_first_operand(c, group, &st.operands[0], &src, &flag1, &value);
+			c.code.appendInstruction(Encoder::instruction(Isa::opcode(st.name), Encoder::immediate(), src));
+			if (flag1 == true) c.code.appendWord(value);
 
-				else if (words[i] == "eqpop" || words[i] == "nepop" || words[i] == "gtpop" || words[i] == "alpop") {
-					if (words.size() < 2) {
-						throw new runtime_error("ERROR: Wrong number of arguments for aritmetical operation");
-					}
+			c.counter += 2;
+			if (flag1 == true)c.counter += 2;
+		}
 
-					string operation = "POP";
-					string op1 = words[i + 1];
-					string dst = "";
-					bool flag1 = false;
-					string value = "";
+		else if (group == Lexer::POP) {
+			if (st.operands.size() < 1) {
+				throw new runtime_error("ERROR: Wrong number of arguments for aritmetical operation");
+			}
 
-					process_first_operand(&operation, &op1, &dst, &flag1, &value);
-					string code = UtilFunctions::binaryToHexa(Instruction::instructions[words[i]]->getOpcode() + dst + "00000");
-					generatedCode[currentSection] = generatedCode[currentSection] + code + value;
+			uint8_t dst = 0;
+			bool flag1 = false;
+			int value = 0;
 
-					locationCounter += 2;
-					if (flag1 == true)locationCounter += 2;
+			process_first_operand(c, group, &st.operands[0], &dst, &flag1, &value);
+			c.code.appendInstruction(Encoder::instruction(Isa::opcode(st.name), dst, Encoder::immediate()));
+			if (flag1 == true) c.code.appendWord(value);
 
-					break;
-				
-				}
-				
-				else if (words[i]=="eqiret" || words[i] == "neiret" || words[i] =="gtiret" || words[i] == "aliret") {
-					string code = UtilFunctions::binaryToHexa(Instruction::instructions[words[i]]->getOpcode() + "0000000000");
-					generatedCode[currentSection]= generatedCode[currentSection] + code;
-					locationCounter += 2;
-					break;
-				}	
-
-				else if (words[i] == "eqret" || words[i] == "neret" || words[i] == "gtret" || words[i] == "alret") {
-					//same as pop pc
-					string code = UtilFunctions::binaryToHexa(Instruction::instructions[words[i]]->getOpcode() + "01111" + "00000"); //regdir i pc
-					generatedCode[currentSection] = generatedCode[currentSection] + code;
-
-					locationCounter += 2;
-					break;
-				}
+			c.counter += 2;
+			if (flag1 == true)c.counter += 2;
+		}
 
-				else if (words[i] == "eqjmp" || words[i] == "nejmp" || words[i] == "gtjmp" || words[i] == "aljmp") {
-					if (words.size() < 2) {
-						throw new runtime_error("ERROR: Wrong number of arguments for aritmetical operation");
-					}
+		else if (group == Lexer::IRET) {
+			c.code.appendInstruction(Encoder::instruction(Isa::opcode(st.name), Encoder::immediate(), Encoder::immediate()));
+			c.counter += 2;
+		}
+
+		else if (group == Lexer::RET) {
+			//same as pop pc
+			c.code.appendInstruction(Encoder::instruction(Isa::opcode(st.name), Encoder::regDir(Encoder::PC), Encoder::immediate())); //regdir i pc
+
+			c.counter += 2;
+		}
 
-					string operation = "JMP";
-					string op1 = words[i + 1];
-					string dst = "";
-					bool flag1 = false;
-					string value = "";
+		else if (group == Lexer::JMP) {
+			if (st.operands.size() < 1) {
+				throw new runtime_error("ERROR: Wrong number of arguments for aritmetical operation");
+			}
+
+			Operand& op1 = st.operands[0];
+			uint8_t dst = 0;
+			bool flag1 = false;
+			int value = 0;
 
-					string addressing = findAddressing(op1);
+			process_first_operand(c, group, &op1, &dst, &flag1, &value);
 
-					process_first_operand(&operation, &op1, &dst, &flag1, &value);
-					
-					if (addressing == "pcrel") {
-						string code = UtilFunctions::binaryToHexa(Instruction::instructions[words[i] + "add"]->getOpcode() + "01111" + "00000"); //ADD r7, offset(x)
-						generatedCode[currentSection] = generatedCode[currentSection] + code + value;
+			if (op1.type == Lexer::PC_REL) {
+				c.code.appendInstruction(Encoder::instruction(Isa::opcode(st.name), Encoder::regDir(Encoder::PC), Encoder::immediate())); //ADD r7, offset(x)
+				if (flag1 == true) c.code.appendWord(value);
+			}
+			else {
+				if (op1.type == Lexer::REG_IND_POM) {
+					int regNum = op1.text.at(1);
+					if (regNum == 7) {
+						c.code.appendInstruction(Encoder::instruction(Isa::opcode(st.name), Encoder::regDir(Encoder::PC), Encoder::memory())); //ADD r7, offset(x)
+						if (flag1 == true) c.code.appendWord(value);
 					}
 					else {
-						if (addressing == "regIndPom") {
-							string opp = words[i + 1];
-							int regNum = opp.at(1);
-							if (regNum == 7) {
-								string code = UtilFunctions::binaryToHexa(Instruction::instructions[words[i] + "add"]->getOpcode() + "01111" + "10000"); //ADD r7, offset(x)
-								generatedCode[currentSection] = generatedCode[currentSection] + code + value;
-							}
-							else {
-								string code = UtilFunctions::binaryToHexa(Instruction::instructions[words[i] + "mov"]->getOpcode() + "01111" + dst); //MOV r7, ...
-								generatedCode[currentSection] = generatedCode[currentSection] + code + value;
-							}
-						}
-						else {
-							string code = UtilFunctions::binaryToHexa(Instruction::instructions[words[i] + "mov"]->getOpcode() + "01111" + dst); //MOV r7, ...
-							generatedCode[currentSection] = generatedCode[currentSection] + code + value;
-						}
+						c.code.appendInstruction(Encoder::instruction(Encoder::opcode(Isa::condition(st.name), Isa::MOV), Encoder::regDir(Encoder::PC), dst)); //MOV r7, ...
+						if (flag1 == true) c.code.appendWord(value);
 					}
-					
-					locationCounter += 2;
-					if (flag1 == true) locationCounter += 2;
-					break;
 				}
-			
+				else {
+					c.code.appendInstruction(Encoder::instruction(Encoder::opcode(Isa::condition(st.name), Isa::MOV), Encoder::regDir(Encoder::PC), dst)); //MOV r7, ...
+					if (flag1 == true) c.code.appendWord(value);
+				}
 			}
 
-			if (regex_search(words[i], regexMap["SECTION"])) {
-				locationCounter = 0;
-				currentSection = words[i];
-				cout << "New section found " << words[i] << endl;
-				continue;
+			c.counter += 2;
+			if (flag1 == true) c.counter += 2;
+		}
+	}
+
+	else if (st.type == Lexer::SECTION) {
+		c.section = st.name;
+		c.counter = 0;
+		c.start = 0;
+		LOG_DEBUG("New section found " << st.name);
+	}
+
+	else if (st.type == Lexer::DIRECTIVE) {
+		string_view name = st.name;
+		if (name == ".skip" || name == ".align") {
+			LOG_TRACE("Skip or align");
+			int k = 0;
+			try {
+				k = UtilFunctions::toInt(st.operands.at(0).text);
+			}
+			catch (exception e) {
+				throw new runtime_error("ERROR: Invalid argument for directives .skip or .align!");
+			}
+			bool zeroFill = c.section == ".bss" || k >= ZERO_FILL_MIN;
+			if (name == ".skip") {
+				c.counter += k;
+				if (zeroFill) c.code.appendZeroFill(k);
+				else c.code.appendZeros(k);
+			}
+			else if (name == ".align") {
+				if (k == 0) return;
+				int oldLc = c.counter;
+				if ((k & (k - 1)) == 0) {
+					if (c.counter / k * k != c.counter) c.counter = (c.counter / k + 1) * k;
+				}
+				if (c.counter - oldLc > 0) {
+					if (c.section == ".bss") c.code.appendZeroFill(c.counter - oldLc);
+					else c.code.appendZeros(c.counter - oldLc);
+				}
+				else throw new runtime_error("ERROR: Invalid argument for .align directive, argument must be a power of 2");
 			}
+		}
 
-			else if (regex_search(words[i], regexMap["DIRECTIVE"])) {
-				string name = words[i];
-				if (name == ".skip" || name == ".align") {
-					cout << "Skip or align" << endl;
-					i++;
-					int k = 0;
+		else if (name == ".char" || name == ".word" || name == ".long") {
+			int size = UtilFunctions::getDirectiveSize(name);
+			for (int k = 0; k < st.operands.size(); k++) {
+				//IF IT IS A NUMBER, IN DECIMAL
+				if (Lexer::isDecimal(st.operands[k].text)) {	
+					int val = 0;
 					try {
-						k = stoi(words[i]);
+						val = UtilFunctions::toInt(st.operands[k].text);
 					}
 					catch (exception e) {
-						throw new runtime_error("ERROR: Invalid argument for directives .skip or .align!");
-					}
-					if (name == ".skip") {
-						locationCounter += k;
-						string code = "";
-						for (int i = 0; i < 2 * k; i++) {
-							code += "0";
-						}
-						generatedCode[currentSection] += code;
-					}
-					else if (name == ".align") {
-						if (k == 0) continue;
-						int oldLc = locationCounter;
-						if ((k & (k - 1)) == 0) {
-							if (locationCounter / k * k != locationCounter) locationCounter = (locationCounter / k + 1) * k;
-						}
-						if (locationCounter - oldLc > 0) {
-							int j = locationCounter - oldLc;
-							string code = "";
-							for (int i = 0; i < 2 * j; i++) {
-								code = code + "0";
-							}
-							generatedCode[currentSection] += code;
-						}
-						else throw new runtime_error("ERROR: Invalid argument for .align directive, argument must be a power of 2");
+						throw new runtime_error("ERROR: Unexpected conversion error!");
 					}
-				}
-
-				else if (name == ".char" || name == ".word" || name == ".long") {
-					int size = UtilFunctions::getDirectiveSize(name);
-					for (int k = i + 1; k < words.size(); k++) {
-						//IF IT IS A NUMBER, IN DECIMAL
-						if (regex_search(words[k], regexMap["NUMBER"])) {	
-							int val = 0;
-							try {
-								val = stoi(words[k]);
-							}
-							catch (exception e) {
-								throw new runtime_error("ERROR: Unexpected conversion error!");
-							}
-							string code = UtilFunctions::generateCode(val, size);
-							generatedCode[currentSection]+=code;
-							locationCounter += size;
-
-							cout << "Directive with number in dec" << endl;
-						}
-						//NUMBER IN HEX
-						else if (regex_search(words[k], regexMap["OPERAND_HEX"])) {
-							string pom = words[k];
-							pom = pom.substr(2, pom.size());
-							while (pom.size() < 4) {
-								pom = "0" + pom;
-							}
-							char arr[] = { pom[2], pom[3], pom[0], pom[1] };
-							string code(arr);
-							code = code.substr(0, 4);
-							generatedCode[currentSection] += code;
-							locationCounter += size;
-
-							cout << "Directive with number in hex" << endl;
-						}
-						//IF IT IS A SYMBOL
-						else {										
-							Symbol * sym = table->get(words[i + 1]);
-							if (sym == 0) {
-								throw new runtime_error("ERROR: Symbol not defined");
-							}
-							else {
-								if (sym->getLocGlo() == "global") {
-									string code = UtilFunctions::generateCode(0, size);
-									generatedCode[currentSection] += code;
-
-									string address = UtilFunctions::decimalToHexa(locationCounter);
-									RelocationSymbol* rels = new RelocationSymbol(address, false, sym->getNumber());
-									relocationTable->put(currentSection, rels);
-
-									cout << "Directive with global symbol " << sym->getLabel() <<endl;
-								}
-								else if (sym->getLocGlo() == "local") {
-									int offset = sym->getOffset();
-									string code = UtilFunctions::generateCode(offset, size);
-									generatedCode[currentSection] +=code;
-
-									string address = UtilFunctions::decimalToHexa(locationCounter);
-									RelocationSymbol *rels = new RelocationSymbol(address, false, UtilFunctions::getSectionNumber(currentSection));
-									relocationTable->put(currentSection, rels);
-									locationCounter += size;
-
-									cout << "Directive with local symbol " << sym->getLabel() << endl;
-								}
-							}
-						}
-					}
-				
-				} //for else .char .word .long
+					c.code.append(val, size);
+					c.counter += size;
 
+					LOG_TRACE("Directive with number in dec");
+				}
+				//NUMBER IN HEX
+				else if (Lexer::isHex(st.operands[k].text)) {
+					string_view pom = st.operands[k].text.substr(2);
+					c.code.append(UtilFunctions::hexValue(pom), size);
+					c.counter += size;
 
+					LOG_TRACE("Directive with number in hex");
+				}
+				//IF IT IS A SYMBOL
+				else {
+					int val = symbolReference(c, st.operands[0].text, size, false, 0, true);
+					c.code.append(val, size);
+					c.counter += size;
 
+					LOG_TRACE("Directive with symbol " << st.operands[0].text);
+				}
 			}
-			else continue;
+		
+		} //for else .char .word .long
+
+		else if (name == ".incbin") {
+			c.code.appendBytes(st.data);
+			c.counter += st.data.size();
+			LOG_TRACE("Included " << st.data.size() << " bytes");
 		}
 	}
-
 }
 
-void Compiler::process_first_operand(string* operation, string* op1, string* src, bool* flag1, string* value) {
-	string addressing = findAddressing(*op1);
+void Compiler::process_first_operand(Chunk& c, Lexer::InstructionGroup group, Operand* op1, uint8_t* src, bool* flag1, int* value) {
+	Lexer::OperandType addressing = op1->type;
 
-	if (addressing == "immediateDec" || addressing == "immediateHex") {
-		if (*operation == "ARITMETICAL") throw new runtime_error("ERROR: First operand can't be a immediate value in artihmetical operations!");
-		if(*operation == "POP")throw new runtime_error("ERROR: First operand can't be a immediate value in POP instruction!");
-		*src = "00000";
+	if (addressing == Lexer::IMMEDIATE_DEC || addressing == Lexer::IMMEDIATE_HEX) {
+		if (group == Lexer::ARITMETICAL) throw new runtime_error("ERROR: First operand can't be a immediate value in artihmetical operations!");
+		if(group == Lexer::POP)throw new runtime_error("ERROR: First operand can't be a immediate value in POP instruction!");
+		*src = Encoder::immediate();
 		*flag1 = true;
 		
-		if (addressing == "immediateDec") { 
-			int v = stoi(*op1);
-			*value = UtilFunctions::generateCode(v, 2); 
+		if (addressing == Lexer::IMMEDIATE_DEC) { 
+			int v = UtilFunctions::toInt(op1->text);
+			*value = v;
 
-			cout << "First operand is immidiateDec value is " << v << endl;
+			LOG_TRACE("First operand is immidiateDec value is " << v);
 		}
 		else {
-			string opp = *op1;
-			opp = opp.substr(3, opp.size());
-			while (opp.size() < 4) {
-				opp = "0" + opp;
-			}
-			char arr[] = { opp[2], opp[3], opp[0], opp[1] };
-			string code(arr);
-			code = code.substr(0, 4);
-			*value = code; //little endian processor
+			string_view opp = op1->text;
+			opp = opp.substr(3);
+			*value = UtilFunctions::hexValue(opp);
 
-			cout << "First operand is immidiateHex value is " << opp << endl;
+			LOG_TRACE("First operand is immidiateHex value is " << opp);
 		}
 	}
 
-	else if (addressing == "psw") {
-		*src = "00111";
+	else if (addressing == Lexer::PSW) {
+		*src = Encoder::psw();
 		
-		cout << "First operand is psw" << endl;
+		LOG_TRACE("First operand is psw");
 	}
 
-	else if(addressing == "regDir" || addressing == "regDirSpec"){
-		if (addressing == "regDir") {
-			string opp = *op1;
+	else if(addressing == Lexer::REG_DIR || addressing == Lexer::REG_DIR_SPEC){
+		if (addressing == Lexer::REG_DIR) {
+			string_view opp = op1->text;
 			int regNum = opp.at(1) - '0'; //register number
-			string reg = UtilFunctions::decimalToBinary(regNum);
-			*src = "01" + reg;
+			*src = Encoder::regDir(regNum);
 			 
-			cout << "First operand is regDir with register " << regNum << endl;
+			LOG_TRACE("First operand is regDir with register " << regNum);
 		}
 		else {
-			string opp = *op1;
-			if (opp == "sp") *src = "01110"; //r6
-			else if (opp == "pc") *src = "01111"; //r7
+			string_view opp = op1->text;
+			if (opp == "sp") *src = Encoder::regDir(Encoder::SP);
+			else if (opp == "pc") *src = Encoder::regDir(Encoder::PC);
 
-			cout << "First operand is regSpec with register " << opp << endl;
+			LOG_TRACE("First operand is regSpec with register " << opp);
 		}
 	}
 
-	else if (addressing == "immAddr" || addressing == "immAddrHex") {
-		*src = "10000";
+	else if (addressing == Lexer::IMM_ADDR || addressing == Lexer::IMM_ADDR_HEX) {
+		*src = Encoder::memory();
 		*flag1 = true;
 
-		if (addressing == "immAddr") {
-			string opp = *op1;
-			string num = opp.substr(1, opp.size());
-			int v = stoi(num);
-			*value = UtilFunctions::generateCode(v, 2);
+		if (addressing == Lexer::IMM_ADDR) {
+			string_view opp = op1->text;
+			string_view num = opp.substr(1);
+			int v = UtilFunctions::toInt(num);
+			*value = v;
 
-			cout << "First operand is immAddr with value " << v << endl;
+			LOG_TRACE("First operand is immAddr with value " << v);
 		}
 		else {
-			string opp = *op1;
-			opp = opp.substr(3, opp.size());
-			while (opp.size() < 4) {
-				opp = "0" + opp;
-			}
-			char arr[] = { opp[2], opp[3], opp[0], opp[1] };
-			string code(arr);
-			code = code.substr(0, 4);
-			*value = code;
+			string_view opp = op1->text;
+			opp = opp.substr(3);
+			*value = UtilFunctions::hexValue(opp);
 
-			cout << "First operand is immAddrHex with value " << opp << endl;
+			LOG_TRACE("First operand is immAddrHex with value " << opp);
 		}
 	}
 
-	else if (addressing == "memDir") {
-		*src = "10000";
+	else if (addressing == Lexer::MEM_DIR) {
+		*src = Encoder::memory();
 		*flag1 = true;
-		string symName = *op1;
-		Symbol * sym = table->get(symName);
-		if (sym == 0) {
-			throw new runtime_error("ERROR: Unexpected error, there is no symbol in the table");
-		}
-		else {
-			if (sym->getLocGlo() == "local") {
-				*value = UtilFunctions::generateCode(sym->getOffset(), 2);
-				//RELOCATION SYMBOL
-				string address = UtilFunctions::decimalToHexa(locationCounter + 2);
-				RelocationSymbol* rels = new RelocationSymbol(address, false, UtilFunctions::getSectionNumber(sym->getSection()));
-				relocationTable->put(currentSection, rels);
-
-				cout << "First operand is memDir on local symbol " << sym->getLabel() << endl;
-			}
-			else {  //global
-				*value = "0000";
-				//RELOCATION SYMBOL
-				string address = UtilFunctions::decimalToHexa(locationCounter + 2);
-				RelocationSymbol* rels = new RelocationSymbol(address, false, sym->getNumber());
-				relocationTable->put(currentSection, rels);
-
-				cout << "First operand is memDir on global symbol " << sym->getLabel() << endl;
-			}
-		}
+		string_view symName = op1->text;
+		*value = symbolReference(c, symName, 2, false, 0, false);
+
+		LOG_TRACE("First operand is memDir on symbol " << symName);
 	}
 
-	else if (addressing == "symVal") {
-		if (*operation == "ARITMETICAL") throw new runtime_error("ERROR: First operand can't be a immediate value in artihmetical operations!");
-		if (*operation == "POP")throw new runtime_error("ERROR: First operand can't be a immediate value in POP instruction!");
-		*src = "00000";
+	else if (addressing == Lexer::SYM_VAL) {
+		if (group == Lexer::ARITMETICAL) throw new runtime_error("ERROR: First operand can't be a immediate value in artihmetical operations!");
+		if (group == Lexer::POP)throw new runtime_error("ERROR: First operand can't be a immediate value in POP instruction!");
+		*src = Encoder::immediate();
 		*flag1 = true;
-		string opp = *op1;
-		string symName = opp.substr(1, opp.size());
-		Symbol* sym = table->get(symName);
+		string_view opp = op1->text;
+		string_view symName = opp.substr(1);
+		*value = symbolReference(c, symName, 2, false, 0, false);
 
-		if (sym == 0) {
-			throw new runtime_error("ERROR: Unexpected error, there is no symbol in the table");
-		}
-		else {
-			if (sym->getLocGlo() == "local") {
-				*value = UtilFunctions::generateCode(sym->getOffset(), 2);
-				//RELOCATION SYMBOL
-				string address = UtilFunctions::decimalToHexa(locationCounter + 2);
-				RelocationSymbol* rels = new RelocationSymbol(address, false, UtilFunctions::getSectionNumber(sym->getSection()));
-				relocationTable->put(currentSection, rels);
-
-				cout << "First operand is symVal on local symbol " << sym->getLabel() << endl;
-			}
-			else {  //global
-				*value = "0000";
-				//RELOCATION SYMBOL
-				string address = UtilFunctions::decimalToHexa(locationCounter + 2);
-				RelocationSymbol* rels = new RelocationSymbol(address, false, sym->getNumber());
-				relocationTable->put(currentSection, rels);
-
-				cout << "First operand is symVal on global symbol " << sym->getLabel() << endl;
-			}
-		
-		}
+		LOG_TRACE("First operand is symVal on symbol " << symName);
 	}
 
-	else if (addressing == "regIndPom") {
+	else if (addressing == Lexer::REG_IND_POM) {
 		*flag1 = true;
-		string opp = *op1;
-
-		string pom = "";
-		int regNum;
-		bool found = false;
-		for (int i = 0; i < opp.size(); i++) {
-			if (opp[i] == '[') {
-				found = true;
-				regNum = opp.at(i - 1) - '0';
-				continue;
-			}
-			if (opp[i] == ']')found = false;
-			if (found == true && opp[i]!='[') {
-				pom += opp[i];
-			}
-		}
+		string_view opp = op1->text;
 
-		string reg = UtilFunctions::decimalToBinary(regNum);
-		*src = "11" + reg;
+		//r<n>[pom], the register is the character before the bracket
+		size_t open = opp.find('[');
+		size_t close = opp.find(']', open);
+		if (close == string_view::npos) close = opp.size();
+		int regNum = opp.at(open - 1) - '0';
+		string_view pom = opp.substr(open + 1, close - open - 1);
 
-		if (regex_search(pom, regexMap["OPERAND_DEC"]) || regex_search(pom, regexMap["OPERAND_HEX"])) {
-			if (regex_search(pom, regexMap["OPERAND_DEC"])) {
-				int v = stoi(pom);
-				*value = UtilFunctions::generateCode(v, 2);
+		*src = Encoder::regInd(regNum);
 
-				cout << "First operand is regIndPom with immediate pomc in dec " << pom << " and register " << regNum << endl;
+		if (Lexer::isDecimal(pom) || Lexer::isHex(pom)) {
+			if (Lexer::isDecimal(pom)) {
+				int v = UtilFunctions::toInt(pom);
+				*value = v;
+
+				LOG_TRACE("First operand is regIndPom with immediate pomc in dec " << pom << " and register " << regNum);
 			}
 			else {
-				pom = pom.substr(3, pom.size());
-				while (pom.size() < 4) {
-					pom = "0" + pom;
-				}
-				char arr[] = { pom[2], pom[3], pom[0], pom[1] };
-				string code(arr);
-				code = code.substr(0, 4);
-				*value = code;
+				pom = pom.substr(3);
+				*value = UtilFunctions::hexValue(pom);
 
-				cout << "First operand is regIndPom with immediate pomc in hex " << pom << " and register " << regNum << endl;
+				LOG_TRACE("First operand is regIndPom with immediate pomc in hex " << pom << " and register " << regNum);
 			}
 		}
 
-		else if(regex_search(pom, regexMap["OPERAND_MEMDIR"])) { //regex is the same!!!!!!!!
-			Symbol* sym = table->get(pom);
-			if (sym == 0) {
-				throw new runtime_error("ERROR: Unexpected error, there is no symbol in the table!");
-			}
-			else {
-				if (sym->getLocGlo() == "local") {
-					if(regNum!=7)*value = UtilFunctions::generateCode(sym->getOffset(), 2);
-					else *value = UtilFunctions::generateCode(sym->getOffset() - 2, 2); //pcrel
-					//RELOCATION SYMBOL
-					string address = UtilFunctions::decimalToHexa(locationCounter + 2);
-					RelocationSymbol* rels = new RelocationSymbol(address, false, UtilFunctions::getSectionNumber(sym->getSection()));
-					relocationTable->put(currentSection, rels);
-					 
-					cout << "First operand is regIndPom with local  symbol " << sym->getLabel() << " and register " << regNum << endl;
-				}
-				else {  //global
-					if(regNum!=7)*value = "0000";
-					else *value = UtilFunctions::generateCode(-2, 2); //pcrel
-					//RELOCATION SYMBOL
-					string address = UtilFunctions::decimalToHexa(locationCounter + 2);
-					RelocationSymbol* rels = new RelocationSymbol(address, false, sym->getNumber());
-					relocationTable->put(currentSection, rels);
-
-					cout << "First operand is regIndPom with global symbol " << sym->getLabel() << " and register " << regNum << endl;
-				}
-			}
+		else if(Lexer::isSymbol(pom)) { //same rule as memDir
+			*value = symbolReference(c, pom, 2, false, regNum == 7 ? -2 : 0, false); //pcrel for r7
+
+			LOG_TRACE("First operand is regIndPom with symbol " << pom << " and register " << regNum);
 		}
 		
 		else throw new runtime_error("ERROR: Bad syntax for regIndPom addressing");
 	}
 
-	else if (addressing == "pcrel") {
-		*src = "11111";
+	else if (addressing == Lexer::PC_REL) {
+		*src = Encoder::pcRel();
 		*flag1 = true;
-		string opp = *op1;
-		string symName = opp.substr(1, opp.size());
-		Symbol* sym = table->get(symName);
-
-		if (sym == 0) {
-			throw new runtime_error("ERROR: Unexpected error, there is no symbol in the table");
-		}
-		else {
-			if (sym->getLocGlo() == "local") {
-				*value = UtilFunctions::generateCode(sym->getOffset() - 2, 2); //pcrel
-				string address = UtilFunctions::decimalToHexa(locationCounter + 2);
-				RelocationSymbol* rels = new RelocationSymbol(address, true, UtilFunctions::getSectionNumber(sym->getSection()));
-				relocationTable->put(currentSection, rels);
-
-				cout << "First operand is pcrel with local symbol " << sym->getLabel() << " and register " << "pc" << endl;
-			}
-			else { //global
-				*value = UtilFunctions::generateCode(-2, 2); //pcrel
-				string address = UtilFunctions::decimalToHexa(locationCounter + 2);
-				RelocationSymbol* rels = new RelocationSymbol(address, true, sym->getNumber());
-				relocationTable->put(currentSection, rels);
+		string_view opp = op1->text;
+		string_view symName = opp.substr(1);
+		*value = symbolReference(c, symName, 2, true, -2, false); //pcrel
 
-				cout << "First operand is pcrel with global symbol " << sym->getLabel() << " and register " << "pc" << endl;
-			}
-		}
+		LOG_TRACE("First operand is pcrel with symbol " << symName << " and register " << "pc");
 	}
 
 	else {
@@ -754,309 +1058,226 @@ void Compiler::process_first_operand(string* operation, string* op1, string* src
 	
 }
 
-void Compiler::process_second_operand(string* operation, string* op2, string* dst, bool* flag2, string* value) {
-	string addressing = findAddressing(*op2);
+void Compiler::process_second_operand(Chunk& c, Lexer::InstructionGroup group, Operand* op2, uint8_t* dst, bool* flag2, int* value) {
+	Lexer::OperandType addressing = op2->type;
 
-	if (addressing == "immediateDec" || addressing == "immediateHex") {
-		*dst = "00000";
+	if (addressing == Lexer::IMMEDIATE_DEC || addressing == Lexer::IMMEDIATE_HEX) {
+		*dst = Encoder::immediate();
 		*flag2 = true;
 
-		if (addressing == "immediateDec") {
-			int v = stoi(*op2);
-			*value = UtilFunctions::generateCode(v, 2);
+		if (addressing == Lexer::IMMEDIATE_DEC) {
+			int v = UtilFunctions::toInt(op2->text);
+			*value = v;
 
-			cout << "Second operand is immidiateDec value is " << v << endl;
+			LOG_TRACE("Second operand is immidiateDec value is " << v);
 		}
 		else {
-			string opp = *op2;
-			opp = opp.substr(3, opp.size());
-			while (opp.size() < 4) {
-				opp = "0" + opp;
-			}
-			char arr[] = { opp[2], opp[3], opp[0], opp[1] };
-			string code(arr);
-			code = code.substr(0, 4);
-			*value = code;
+			string_view opp = op2->text;
+			opp = opp.substr(3);
+			*value = UtilFunctions::hexValue(opp);
 
-			cout << "Second operand is immidiateHex value is " << opp << endl;
+			LOG_TRACE("Second operand is immidiateHex value is " << opp);
 
 		}
 	}
 
-	else if (addressing == "psw") {
-		*dst = "00111";
+	else if (addressing == Lexer::PSW) {
+		*dst = Encoder::psw();
 
-		cout << "Second operand is immidiateDec value is psw" << endl;
+		LOG_TRACE("Second operand is immidiateDec value is psw");
 	}
 
-	else if (addressing == "regDir" || addressing == "regDirSpec") {
-		if (addressing == "regDir") {
-			string opp = *op2;
+	else if (addressing == Lexer::REG_DIR || addressing == Lexer::REG_DIR_SPEC) {
+		if (addressing == Lexer::REG_DIR) {
+			string_view opp = op2->text;
 			int regNum =opp.at(1) - '0'; //register number
-			string reg = UtilFunctions::decimalToBinary(regNum);
-			*dst = "01" + reg;
+			*dst = Encoder::regDir(regNum);
 
-			cout << "Second operand is regDir register is " << regNum << endl;
+			LOG_TRACE("Second operand is regDir register is " << regNum);
 
 		}
 		else {
-			string opp = *op2;
-			if (opp == "sp") *dst = "01110"; //r6
-			else if (opp == "pc") *dst = "01111"; //r7
+			string_view opp = op2->text;
+			if (opp == "sp") *dst = Encoder::regDir(Encoder::SP);
+			else if (opp == "pc") *dst = Encoder::regDir(Encoder::PC);
 
-			cout << "Second operand is regDirSpec register is " << opp << endl;
+			LOG_TRACE("Second operand is regDirSpec register is " << opp);
 
 		}
 	}
 
-	else if (addressing == "immAddr" || addressing == "immAddrHex") {
-		*dst = "10000";
+	else if (addressing == Lexer::IMM_ADDR || addressing == Lexer::IMM_ADDR_HEX) {
+		*dst = Encoder::memory();
 		*flag2 = true;
 
-		if (addressing == "immAddr") {
-			string opp = *op2;
-			string num = opp.substr(1, opp.size());
-			int v = stoi(num);
-			*value = UtilFunctions::generateCode(v, 2);
+		if (addressing == Lexer::IMM_ADDR) {
+			string_view opp = op2->text;
+			string_view num = opp.substr(1);
+			int v = UtilFunctions::toInt(num);
+			*value = v;
 
-			cout << "Second operand is immAddr value is " << v << endl;
+			LOG_TRACE("Second operand is immAddr value is " << v);
 
 		}
 		else {
-			string opp = *op2;
-			opp = opp.substr(3, opp.size());
-			while (opp.size() < 4) {
-				opp = "0" + opp;
-			}
-			char arr[] = { opp[2], opp[3], opp[0], opp[1] };
-			string code(arr);
-			code = code.substr(0, 4);
-			*value = code;
+			string_view opp = op2->text;
+			opp = opp.substr(3);
+			*value = UtilFunctions::hexValue(opp);
 
-			cout << "Second operand is immAddrHex value is " << opp << endl;
+			LOG_TRACE("Second operand is immAddrHex value is " << opp);
 
 		}
 	}
 
-	else if (addressing == "memDir") {
-		*dst = "10000";
+	else if (addressing == Lexer::MEM_DIR) {
+		*dst = Encoder::memory();
 		*flag2 = true;
-		string symName = *op2;
-		Symbol * sym = table->get(symName);
-		if (sym == 0) {
-			throw new runtime_error("ERROR: Unexpected error, there is no symbol in the table");
-		}
-		else {
-			if (sym->getLocGlo() == "local") {
-				*value = UtilFunctions::generateCode(sym->getOffset(), 2);
-				//RELOCATION SYMBOL
-				string address = UtilFunctions::decimalToHexa(locationCounter + 2);
-				RelocationSymbol* rels = new RelocationSymbol(address, false, UtilFunctions::getSectionNumber(sym->getSection())); //section entry number
-				relocationTable->put(currentSection, rels);
-
-				cout << "Second operand is memDir with local symbol " << sym->getLabel() << endl;
-			}
-			else {  //global
-				*value = "0000";
-				//RELOCATION SYMBOL
-				string address = UtilFunctions::decimalToHexa(locationCounter + 2);
-				RelocationSymbol* rels = new RelocationSymbol(address, false, sym->getNumber()); //entry number
-				relocationTable->put(currentSection, rels);
-
-				cout << "Second operand is memDir with global symbol " << sym->getLabel() << endl;
-			}
-		}
+		string_view symName = op2->text;
+		*value = symbolReference(c, symName, 2, false, 0, false);
 
+		LOG_TRACE("Second operand is memDir on symbol " << symName);
 	}
 
-	else if (addressing == "symVal") {
-		*dst = "00000";
+	else if (addressing == Lexer::SYM_VAL) {
+		*dst = Encoder::immediate();
 		*flag2 = true;
-		string opp = *op2;
-		string symName = opp.substr(1, opp.size());
-		Symbol* sym = table->get(symName);
+		string_view opp = op2->text;
+		string_view symName = opp.substr(1);
+		*value = symbolReference(c, symName, 2, false, 0, false);
 
-		if (sym == 0) {
-			throw new runtime_error("ERROR: Unexpected error, there is no symbol in the table");
-		}
-		else {
-			if (sym->getLocGlo() == "local") {
-				*value = UtilFunctions::generateCode(sym->getOffset(), 2);
-				//RELOCATION SYMBOL
-				string address = UtilFunctions::decimalToHexa(locationCounter + 2);
-				RelocationSymbol* rels = new RelocationSymbol(address, false, UtilFunctions::getSectionNumber(sym->getSection()));
-				relocationTable->put(currentSection, rels);
-
-				cout << "Second operand is symVal with local symbol " << sym->getLabel() << endl;
-			}
-			else {  //global
-				*value = "0000";
-				//RELOCATION SYMBOL
-				string address = UtilFunctions::decimalToHexa(locationCounter + 2);
-				RelocationSymbol* rels = new RelocationSymbol(address, false, sym->getNumber());
-				relocationTable->put(currentSection, rels);
-
-				cout << "Second operand is symVal with global symbol " << sym->getLabel() << endl;
-			}
-
-		}
+		LOG_TRACE("Second operand is symVal on symbol " << symName);
 	}
 
-	else if (addressing == "regIndPom") {
+	else if (addressing == Lexer::REG_IND_POM) {
 		*flag2 = true;
-		string opp = *op2;
-
-		string pom = "";
-		int regNum;
-		bool found = false;
-		for (int i = 0; i < opp.size(); i++) {
-			if (opp[i] == '[') {
-				found = true;
-				regNum =opp.at(i - 1) - '0';
-			}
-			if (opp[i] == ']')found = false;
-			if (found == true && opp[i]!='[') {
-				pom += opp[i];
-			}
-		}
+		string_view opp = op2->text;
+
+		//r<n>[pom], the register is the character before the bracket
+		size_t open = opp.find('[');
+		size_t close = opp.find(']', open);
+		if (close == string_view::npos) close = opp.size();
+		int regNum = opp.at(open - 1) - '0';
+		string_view pom = opp.substr(open + 1, close - open - 1);
 
-		string reg = UtilFunctions::decimalToBinary(regNum);
-		*dst = "11" + reg;
+		*dst = Encoder::regInd(regNum);
 
-		if (regex_search(pom, regexMap["OPERAND_DEC"]) || regex_search(pom, regexMap["OPERAND_HEX"])) {
-			if (regex_search(pom, regexMap["OPERAND_DEC"])) {
-				int v = stoi(pom);
-				*value = UtilFunctions::generateCode(v, 2);
+		if (Lexer::isDecimal(pom) || Lexer::isHex(pom)) {
+			if (Lexer::isDecimal(pom)) {
+				int v = UtilFunctions::toInt(pom);
+				*value = v;
 
-				cout << "Second operand is regIndPom with immediate pomc in dec " << v << " and register " << regNum << endl;
+				LOG_TRACE("Second operand is regIndPom with immediate pomc in dec " << v << " and register " << regNum);
 			}
 			else {
-				pom = pom.substr(3, pom.size());
-				while (pom.size() < 4) {
-					pom = "0" + pom;
-				}
-				char arr[] = { pom[2], pom[3], pom[0], pom[1] };
-				string code(arr);
-				code = code.substr(0, 4);
-				*value = code;
+				pom = pom.substr(3);
+				*value = UtilFunctions::hexValue(pom);
 
-				cout << "Second operand is regIndPom with immediate pomc in hex " << pom << " and register " << regNum << endl;
+				LOG_TRACE("Second operand is regIndPom with immediate pomc in hex " << pom << " and register " << regNum);
 			}
 		}
 
-		else if (regex_search(pom, regexMap["OPERAND_MEMDIR"])) { //regex is the same!!!!!!!!
-			Symbol* sym = table->get(pom);
-			if (sym == 0) {
-				throw new runtime_error("ERROR: Unexpected error, there is no symbol in the table!");
-			}
-			else {
-				if (sym->getLocGlo() == "local") {
-					if (regNum != 7)*value = UtilFunctions::generateCode(sym->getOffset(), 2);
-					else *value = UtilFunctions::generateCode(sym->getOffset() - 2, 2); //pcrel
-					//RELOCATION SYMBOL
-					string address = UtilFunctions::decimalToHexa(locationCounter + 2);
-					RelocationSymbol* rels = new RelocationSymbol(address, false, UtilFunctions::getSectionNumber(sym->getSection()));
-					relocationTable->put(currentSection, rels);
-
-					cout << "Second operand is regIndPom with local symbol " << sym->getLabel() << " and register " << regNum << endl;
-				}
-				else {  //global
-					if (regNum != 7)*value = "0000";
-					else *value = UtilFunctions::generateCode(-2, 2); //pcrel
-					//RELOCATION SYMBOL
-					string address = UtilFunctions::decimalToHexa(locationCounter + 2);
-					RelocationSymbol* rels = new RelocationSymbol(address, false, sym->getNumber());
-					relocationTable->put(currentSection, rels);
-
-					cout << "Second operand is regIndPom with global symbol " << sym->getLabel() << " and register " << regNum << endl;
-				}
-			}
+		else if (Lexer::isSymbol(pom)) { //same rule as memDir
+			*value = symbolReference(c, pom, 2, false, regNum == 7 ? -2 : 0, false); //pcrel for r7
+
+			LOG_TRACE("Second operand is regIndPom with symbol " << pom << " and register " << regNum);
 		}
 		
 		else throw new runtime_error("ERROR: Bad syntax for regIndPom addressing");
 	}
 
-	else if (addressing == "pcrel") {
-		*dst = "11111";
+	else if (addressing == Lexer::PC_REL) {
+		*dst = Encoder::pcRel();
 		*flag2 = true;
-		string opp = *op2;
-		string symName = opp.substr(1, opp.size());
-		Symbol* sym = table->get(symName);
-
-		if (sym == 0) {
-			throw new runtime_error("ERROR: Unexpected error, there is no symbol in the table");
-		}
-		else {
-			if (sym->getLocGlo() == "local") {
-				*value = UtilFunctions::generateCode(sym->getOffset() - 2, 2); //pcrel
-				string address = UtilFunctions::decimalToHexa(locationCounter + 2);
-				RelocationSymbol* rels = new RelocationSymbol(address, true, UtilFunctions::getSectionNumber(sym->getSection()));
-				relocationTable->put(currentSection, rels);
+		string_view opp = op2->text;
+		string_view symName = opp.substr(1);
+		*value = symbolReference(c, symName, 2, true, -2, false); //pcrel
 
-				cout << "Second operand is pcrel with local symbol " << sym->getLabel() << " and register " << "pc" << endl;
-			}
-			else {
-				*value = UtilFunctions::generateCode(-2, 2); //pcrel
-				string address = UtilFunctions::decimalToHexa(locationCounter + 2);
-				RelocationSymbol* rels = new RelocationSymbol(address, false, sym->getNumber());
-				relocationTable->put(currentSection, rels);
-
-				cout << "Second operand is pcrel with global symbol " << sym->getLabel() << " and register " << "pc" << endl;
-			}
-		}
+		LOG_TRACE("Second operand is pcrel with symbol " << symName << " and register " << "pc");
 	}
 
-
 	else {
 		throw new runtime_error("ERROR: Can not find specified addressing");
 	}
 
 }
 
-string Compiler::findAddressing(string op) {
-	if (regex_search(op, regexMap["OPERAND_DEC"])) {
-		return "immediateDec";
+//operand values follow the instruction word, directive values are written in place
+int Compiler::symbolReference(Chunk& c, string_view symbol, int size, bool relative, int addend, bool directive) {
+	int offset = c.start + c.code.size();
+	int address = c.counter;
+	if (!directive) {
+		offset += 2;
+		address += 2;
 	}
-	else if (regex_search(op, regexMap["OPERAND_HEX"])) {
-		return "immediateHex";
+	Fixup f(symbol, c.section, offset, address, size, relative, addend, directive);
+	if (!singlePass) {
+		RelocationSymbol rel;
+		int value = 0;
+		if (resolve(f, value, rel)) c.relocations.push_back(rel);
+		return value;
 	}
 
-	else if (regex_search(op, regexMap["OPERAND_PSW"])) {
-		return "psw";
-	}
+	//symbol may still be defined or declared global later in the file
+	fixups.push_back(f);
+	return 0;
+}
 
-	else if (regex_search(op, regexMap["OPERAND_REG"])) {
-		return "regDir";
+//VALUE OF THE REFERENCE AND ITS RELOCATION ENTRY, false if it needs no entry
+bool Compiler::resolve(Fixup& f, int& value, RelocationSymbol& rel) {
+	Symbol* sym = table->get(f.getSymbol());
+	if (sym == 0) throw new runtime_error("ERROR: Symbol " + string(f.getSymbol()) + " is not defined");
+
+	string address = UtilFunctions::decimalToHexa(f.getAddress());
+	bool global = sym->getLocGlo() == "global";
+	string section = "";
+	if (global) {
+		rel = RelocationSymbol(address, f.isRelative(), sym->getNumber());
+		value = f.getAddend();
 	}
-	else if (regex_search(op, regexMap["OPERAND_REGSPEC"])) {
-		return "regDirSpec";
+	else {
+		section = f.isDirective() ? f.getSection() : sym->getSection();
+		rel = RelocationSymbol(address, f.isRelative(), UtilFunctions::getSectionNumber(section));
+		value = sym->getOffset() + f.getAddend();
 	}
 
-	else if (regex_search(op, regexMap["OPERAND_SYMBOL"])) {
-		return "symVal";
-	}
+	//FIXED ADDRESSES, the value the loader would patch in, it reads and writes two bytes
+	if (!fixedAddresses || f.getSize() != 2 || sym->getSection() == "UND") return true;
 
-	else if (regex_search(op, regexMap["OPERAND_MEMDIR"])) {
-		return "memDir";
+	int target = 0;
+	int here = 0;
+	if (global) {
+		if (!sectionStart(sym->getSection(), target)) return true;
+		target += sym->getOffset();
 	}
+	else if (!sectionStart(section, target)) return true;
+	if (f.isRelative() && !sectionStart(f.getSection(), here)) return true;
 
-	else if (regex_search(op, regexMap["OPERAND_IMMADDR"])) {
-		return "immAddr";
-	}
-	else if (regex_search(op, regexMap["OPERAND_IMMADDRHEX"])) {
-		return "immAddrHex";
-	}
+	value = (int16_t)value + target;
+	if (f.isRelative()) value -= f.getAddress() + here;
+	if (value < 0) value = (int16_t)value; //the loader keeps the low 16 bits of a negative value
+	return false;
+}
 
-	else if (regex_search(op, regexMap["OPERAND_REGINDPOM"])) {
-		return "regIndPom";
+bool Compiler::sectionStart(const string& name, int& start) {
+	for (int i = 0; i < sections.size(); i++) {
+		if (sections[i].getName() == name) {
+			start = sections[i].getStart();
+			return true;
+		}
 	}
+	return false;
+}
 
-	else if (regex_search(op, regexMap["OPERAND_PCREL"])) {
-		return "pcrel";
+//PATCH THE VALUES IN THE ORDER THE REFERENCES WERE READ
+void Compiler::resolveFixups() {
+	for (int i = 0; i < fixups.size(); i++) {
+		Fixup& f = fixups[i];
+		RelocationSymbol rel;
+		int value = 0;
+		if (resolve(f, value, rel)) relocationTable->put(f.getSection(), rel);
+		generatedCode[f.getSection()].patch(f.getOffset(), value, f.getSize());
 	}
-
-	else return "not found";
-
+	fixups.clear();
 }
 
 void Compiler::writeToFile(ofstream &outFile) {
@@ -1074,19 +1295,60 @@ void Compiler::writeToFile(ofstream &outFile) {
 	relocationTable->print(outFile);
 	outFile << endl;
 
+	//ZERO FILL, the loader maps these bytes, they are not in the code below
+	const char* names[] = { ".data", ".text", ".rodata" };
+	vector<Section> zeroFill;
+	for (int i = 0; i < 3; i++) {
+		const vector<CodeBuffer::Extent>& extents = generatedCode[names[i]].getZeroFill();
+		for (int k = 0; k < extents.size(); k++) zeroFill.push_back(Section(names[i], extents[k].offset, extents[k].length));
+	}
+	for (int i = 0; i < sections.size(); i++) {
+		if (sections[i].getName() == ".bss" && sections[i].getLength() > 0) zeroFill.push_back(Section(".bss", 0, sections[i].getLength()));
+	}
+	if (zeroFill.size() > 0) {
+		outFile << "#Zero_fill" << endl;
+		outFile << "Section name" << "\t" << "Offset" << "\t\t" << "Length" << endl;
+		for (int i = 0; i < zeroFill.size(); i++) {
+			outFile << zeroFill[i].getName() << "\t\t" << zeroFill[i].getStart() << "\t\t" << zeroFill[i].getLength() << endl;
+		}
+		outFile << endl;
+	}
+
 	outFile << "#.data" << endl;
-	string genc = generatedCode[".data"];
+	string genc = generatedCode[".data"].toHex();
 	outFile << genc << endl;
 
 	outFile << "#.text" << endl;
-	genc = generatedCode[".text"];
+	genc = generatedCode[".text"].toHex();
 	outFile << genc << endl;
 
 	outFile << "#.rodata" << endl;
-	genc = generatedCode[".rodata"];
+	genc = generatedCode[".rodata"].toHex();
 	outFile << genc << endl;
 
 
 
 
 }
+
+//SAME CONTENT AS writeToFile, copied out of the compiler so the object outlives it
+void Compiler::toObject(ObjectModule& object) {
+	for (int i = 0; i < sections.size(); i++) {
+		string name = sections[i].getName();
+		if (name == "") continue; //.end before any section
+		ObjectSection section(name, sections[i].getStart(), sections[i].getLength());
+
+		map<string, CodeBuffer>::iterator code = generatedCode.find(name);
+		if (code != generatedCode.end()) {
+			section.getBytes() = code->second.getBytes();
+			section.getZeroFill() = code->second.getZeroFill();
+		}
+		else if (section.getLength() > 0) section.getZeroFill().push_back(CodeBuffer::Extent{ 0, section.getLength() }); //.bss
+		section.getRelocations() = relocationTable->get(name);
+		object.getSections().push_back(section);
+	}
+
+	vector<Symbol*> symbols = table->getSymbols();
+	object.getSymbols().reserve(symbols.size());
+	for (int i = 0; i < symbols.size(); i++) object.getSymbols().push_back(*symbols[i]);
+}
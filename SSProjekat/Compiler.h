@@ -1,33 +1,136 @@
 #ifndef COMPILER_H
 #define COMPILER_H
 #include <unordered_map> 
+#include <istream>
+#include <memory>
 #include <string>
-#include<regex>
+#include <string_view>
 #include <vector>
 
 #include "SymbolTable.h"
 #include "RelocationSymbolTable.h"
 #include "Section.h"
+#include "Statement.h"
+#include "Fixup.h"
+#include "CodeBuffer.h"
+#include "Arena.h"
+#include "MappedFile.h"
+#include "SpscQueue.h"
+#include "PhaseReport.h"
+#include "ObjectModule.h"
 
 using namespace std;
 
 class Compiler {
 public:
+	//change it whenever the same source would give a different object, cached objects depend on it
+	static constexpr const char* VERSION = "2.0";
+
 	Compiler();
 	~Compiler();
 
-	void compile(ifstream &inFIle, ofstream &outFile, int startAddress);
-
-	static map<string, regex> regexMap;
+	//false if the source has errors, getError tells which
+	bool compile(ifstream &inFIle, ofstream &outFile, int startAddress);
+	//maps the file instead of reading it
+	bool compileFile(const string& path, ofstream &outFile, int startAddress);
+	//starts assembling while the source is still arriving, for example on a pipe,
+	//reading, tokenizing and encoding run on their own threads, always in single pass mode
+	bool compileStream(istream &in, ofstream &outFile, int startAddress);
+	//assembles in memory, nothing is written and nothing is thrown, errors are diagnostics of the object,
+	//the source is only read during the call. Unlike the calls above it can be made again on the same
+	//compiler, every call starts from scratch and keeps only the settings (and the report, which adds up)
+	ObjectModule assemble(string_view source, int startAddress);
+	string getError();
+	void setSinglePass(bool singlePass);
+	//threads of the second run, big sources are encoded in chunks at once
+	void setThreads(int threads);
+	//peephole pass over .text between the runs, only in the two pass mode
+	void setOptimize(bool optimize);
+	//the object is only loaded at the start address, references to its own symbols are
+	//resolved here and only references to other objects get relocations
+	void setFixedAddresses(bool fixedAddresses);
+	//time and allocations of every phase go into the report, it is filled in by the compile call,
+	//the streaming mode overlaps reading, tokenizing and encoding, they are all counted in pass one
+	void setReport(PhaseReport* report);
 
 private:
-	void firstRun(ifstream &inFile);
-	void secondRun(ifstream &inFile);
+	//Statements encoded into their own code and relocations, then merged into the section.
+	//The second run makes one per section, or more for a big section,
+	//the single pass mode keeps one for the section that is being read.
+	struct Chunk {
+		int first = 0;		//statements [first, last)
+		int last = 0;
+		string section = "";
+		int counter = 0;	//location counter of the encoder
+		int start = 0;		//offset of the code in the section
+		CodeBuffer code;
+		vector<RelocationSymbol> relocations;
+		string error = "";
+		int errorLine = 0;
+	};
+
+	static constexpr int CHUNK_STATEMENTS = 4096;
+	//.skip of at least this many bytes is written as a zero fill extent, .bss always is
+	static constexpr int ZERO_FILL_MIN = 64;
+
+	//STAGES OF THE STREAMING MODE
+	struct SourceBlock {
+		string_view text;	//whole lines, except in the last block
+		bool last = false;
+	};
+
+	struct StatementBatch {
+		vector<Statement> statements;
+		bool last = false;
+		string error = "";	//first run error on the line after the statements
+	};
+
+	static constexpr size_t PIPELINE_BLOCK = 64 * 1024;
+	static constexpr int PIPELINE_DEPTH = 16;
+
+	void pipeline(istream& in);
+	void readStage(istream& in, SpscQueue<SourceBlock>& out);
+	void tokenizeStage(SpscQueue<SourceBlock>& in, SpscQueue<StatementBatch>& out);
+	char* newBlock(size_t size);
+
+	bool run(string_view source, ofstream &outFile, int startAddress);
+	void build(string_view source, int startAddress);
+	void firstRun(string_view source);
+	bool readLine(string_view line, int lineNumber);
+	static string_view nextLine(string_view source, size_t& pos);
+	void endOfSource();
+	void peephole();
+	void relayout();
+	static int locationAfter(Statement& st, int counter);
+	string_view includeBinary(Statement& st);
+	static long long includeArgument(string_view text);
+	void secondRun();
+	void encode(Chunk& c, Statement& st);
+	void encodeChunk(Chunk& c);
+	void merge(Chunk& c);
+	void encodePending();
+	void resolveFixups();
+	void reset();
 	void writeToFile(ofstream &outFile);
+	void toObject(ObjectModule& object);
+	void fillReport();
 
-	void process_first_operand(string* operation, string* op, string* src, bool* flag, string* value);
-	void process_second_operand(string* operation, string* op, string* src, bool* flag, string* value);
-	string findAddressing(string op);
+	void process_first_operand(Chunk& c, Lexer::InstructionGroup group, Operand* op, uint8_t* src, bool* flag, int* value);
+	void process_second_operand(Chunk& c, Lexer::InstructionGroup group, Operand* op, uint8_t* src, bool* flag, int* value);
+	int symbolReference(Chunk& c, string_view symbol, int size, bool relative, int addend, bool directive);
+	bool resolve(Fixup& f, int& value, RelocationSymbol& rel);
+	bool sectionStart(const string& name, int& start);
+
+	Arena arena; //owns the tables, freed with the compiler
+
+	//statements point into the source, one of these holds it for the whole compilation
+	MappedFile input;
+	string buffer;
+	istream* stream;
+	vector<unique_ptr<char[]>> blocks; //filled by the reader of the streaming mode
+	vector<unique_ptr<MappedFile>> binaries; //files of .incbin, statements point into them
+	string readError;
+	vector<string_view> words; //words of the current line, reused
 
 	string currentSection;
 	int number;
@@ -38,7 +141,25 @@ private:
 	vector<Section> sections;
 
 	RelocationSymbolTable* relocationTable;
-	map<string, string> generatedCode;
+	map<string, CodeBuffer> generatedCode;
+
+	vector<Statement> statements;
+
+	//single pass mode encodes every line as soon as it is read
+	//and patches symbol values at .end
+	bool singlePass;
+	vector<Fixup> fixups;
+	Chunk pending;
+
+	int threads;
+	bool optimize;
+	bool fixedAddresses;
+
+	PhaseReport* report;
+	int lines;
+
+	string error;
+	int errorLine;	//line of the error, 0 when it is not known
 
 
 };
@@ -1,22 +1,74 @@
 #ifndef CPU_H
 #define CPU_H
 #include "Memory.h"
+#include "Mmu.h"
+#include "Isa.h"
+
+#include <array>
+#include <utility>
 using namespace std;
 
 
 class Cpu {
 private:
 	Memory* mem;
+	Mmu* mmu;
 	int *stack;
+
+	string readByte(int address) {
+		if (mmu != 0) return mmu->read(address);
+		return mem->readRamByte(address);
+	}
+	string fetchByte(int address) {
+		if (mmu != 0) return mmu->read(address, MemoryObserver::FETCH);
+		return mem->readRamByte(address, MemoryObserver::FETCH);
+	}
+	void writeByte(int address, string data) {
+		if (mmu != 0) mmu->write(address, data);
+		else mem->writeRamByte(address, data);
+	}
+
+	//instruction word split into its fields
+	struct Fields {
+		int operation;
+		int addressing1;
+		int reg1;
+		int addressing2;
+		int reg2;
+	};
+
+	bool aritmetical(Fields& f);
+	bool logical(Fields& f);
+	bool pushCall(Fields& f);
+	bool pop(Fields& f);
+	bool iret(Fields& f);
+
+	//ONE HANDLER PER OPERATION, GENERATED FROM THE ISA TABLE
+	typedef bool (Cpu::*Handler)(Fields& f);
+	static constexpr Handler handlerFor(Lexer::InstructionGroup group) {
+		return group == Lexer::ARITMETICAL ? &Cpu::aritmetical
+			: group == Lexer::LOGICAL ? &Cpu::logical
+			: group == Lexer::PUSHCALL ? &Cpu::pushCall
+			: group == Lexer::POP ? &Cpu::pop
+			: &Cpu::iret;
+	}
+	template<size_t... I>
+	static constexpr array<Handler, Isa::OPERATION_COUNT> makeHandlers(index_sequence<I...>) {
+		return {{ handlerFor(Isa::group(I))... }};
+	}
+	static const array<Handler, Isa::OPERATION_COUNT> HANDLERS;
 public:
-	Cpu(Memory* mem) {
+	Cpu(Memory* mem, Mmu* mmu = 0) {
 		this->mem = mem;
+		this->mmu = mmu;
 		stack = new int[1000];
 		regs[SP] = 1001;
+		stackWrites = 0;
 	};
 	~Cpu() {};
 
 	bool decodeAndExec();
+	void interrupt(int routine);
 
 	static int interruptRegister;
 	static const int timer_interrupt = 1;
@@ -27,6 +79,7 @@ public:
 
 
 	int regs[9];
+	unsigned long stackWrites;
 	static const int SP = 6;
 	static const int PC = 7;
 	static const int PSW = 8;
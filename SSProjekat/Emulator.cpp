@@ -1,8 +1,12 @@
 #include "Emulator.h"
 #include <sstream>
+#include <algorithm>
+#include <thread>
+#include <cmath>
 #include "UtilFunctions.h"
 #include "RelocationSymbol.h"
 #include "RelocationSymbolTable.h"
+#include "Log.h"
 
 using namespace std;
 
@@ -26,21 +30,16 @@ vector<string> Emulator::split(string line) {
 }
 
 void Emulator::load(int argc, char** argv) {
+	arena.reset();
 
 	for (int i = 1; i < argc - 1; i++) {
-		sections.push_back(new Section());
-		sections.push_back(new Section());
-		sections.push_back(new Section());
-		sections.push_back(new Section());
+		for (int k = 0; k < 4; k++) sections.push_back(arena.make<Section>());
 		createSymbolTable(argv[i]);
 		sections.clear();
 	}
 
 	for (int i = 1; i < argc - 1; i++) {
-		sections.push_back(new Section());
-		sections.push_back(new Section());
-		sections.push_back(new Section());
-		sections.push_back(new Section());
+		for (int k = 0; k < 4; k++) sections.push_back(arena.make<Section>());
 		resolveRelocation(argv[i]);
 		sections.clear();
 	}
@@ -69,7 +68,7 @@ void Emulator::createSymbolTable(string name) {
 			int length = stoi(words[2]);
 
 			int n = UtilFunctions::getSectionNumber(sectionName);
-			Section * s = new Section(sectionName, start, length);
+			Section * s = arena.make<Section>(sectionName, start, length);
 			sections[n - 1] = s;
 		}
 	}
@@ -99,8 +98,7 @@ void Emulator::createSymbolTable(string name) {
 					int n = UtilFunctions::getSectionNumber(section);
 					int start = sections[n - 1]->getStart();
 					offset = offset + start;
-					sym = new Symbol(symName, section, offset, locGlo, num);
-					table.put(symName, sym);
+					table.put(Symbol(symName, section, offset, locGlo, num));
 				}
 			}
 		}
@@ -117,9 +115,10 @@ void Emulator::resolveRelocation(string name) {
 	}
 
 	string line = "";
-	SymbolTable* localTable = new SymbolTable();
-	RelocationSymbolTable* relocationTable = new RelocationSymbolTable();
+	SymbolTable* localTable = arena.make<SymbolTable>();
+	RelocationSymbolTable* relocationTable = arena.make<RelocationSymbolTable>();
 	string genCode[4];
+	vector<pair<int, int>> zeroFill[4]; //offset and length, the bytes are not in genCode
 	getline(inFile, line);
 	line = line.substr(0, line.size());
 
@@ -136,7 +135,7 @@ void Emulator::resolveRelocation(string name) {
 			int length = stoi(words[2]);
 
 			int n = UtilFunctions::getSectionNumber(sectionName);
-			Section * s = new Section(sectionName, start, length);
+			Section * s = arena.make<Section>(sectionName, start, length);
 			sections[n - 1] = s;
 		}
 	}
@@ -169,8 +168,13 @@ void Emulator::resolveRelocation(string name) {
 				}
 			}
 			
-			Symbol *sym = new Symbol(symName, section, offset, locGlo, num);
-			localTable->put(symName, sym);
+			//relocations name symbols by number, older assemblers gave a global defined after .global the number of the next symbol
+			if (localTable->getByNum(num) != 0) throw new runtime_error("ERROR: Two symbols with number " + to_string(num) + " in " + name + ", assemble it again!");
+
+			Symbol sym(symName, section, offset, locGlo, num);
+			localTable->put(sym);
+			//local labels like loop repeat in many files
+			if (section != "UND") loadedSymbols.put(Symbol(locGlo == "local" ? name + ":" + symName : symName, section, offset, locGlo, num));
 		}
 	}	
 
@@ -195,8 +199,16 @@ void Emulator::resolveRelocation(string name) {
 				string type = words[1];
 				int num = stoi(words[2]);
 
-				RelocationSymbol *rs = new RelocationSymbol(to_string(adr), type=="R_386_PC32", num);
-				relocationTable->put(sec, rs);
+				relocationTable->put(sec, RelocationSymbol(to_string(adr), type=="R_386_PC32", num));
+			}
+		}
+		else if (line == "#Zero_fill") {
+			getline(inFile, line); //read table header
+
+			while (getline(inFile, line)) {
+				if (line == "") break;
+				vector<string> words = split(line);
+				zeroFill[UtilFunctions::getSectionNumber(words[0]) - 1].push_back(make_pair(stoi(words[1]), stoi(words[2])));
 			}
 		}
 		else if (line == "#.data" || line == "#.text" || line == "#.rodata" || line == "#.bss") {
@@ -207,12 +219,13 @@ void Emulator::resolveRelocation(string name) {
 			for (int i = 0; i < rels.size(); i++) {
 				RelocationSymbol r = rels[i];
 				int addr = stoi(r.getAddress());
+				int at = 2 * codeOffset(zeroFill[UtilFunctions::getSectionNumber(sec) - 1], addr);
 				bool type = r.getType();
 				int num = r.getNumber();
 
 				if (type) {	//PCREL
-					char pod[4] = { code[2*addr + 2], code[2*addr + 3], code[2*addr], code[2*addr + 1] };
-					string dat(pod);
+					char pod[4] = { code[at + 2], code[at + 3], code[at], code[at + 1] };
+					string dat(pod, 4);
 					dat = dat.substr(0, 4);
 					int d = UtilFunctions::hexToDecimal(dat); //GET THE DATA IN INT
 					Symbol* sym = localTable->getByNum(num);
@@ -227,14 +240,14 @@ void Emulator::resolveRelocation(string name) {
 					int n = UtilFunctions::getSectionNumber(sec);
 					d = d - addr - sections[n - 1]->getStart();
 					string g = UtilFunctions::generateCode(d, 2);
-					code[2*addr] = g[0];
-					code[2*addr + 1] = g[1];
-					code[2*addr + 2] = g[2];
-					code[2*addr + 3] = g[3];
+					code[at] = g[0];
+					code[at + 1] = g[1];
+					code[at + 2] = g[2];
+					code[at + 3] = g[3];
 				}
 				else { //ABS
-					char pod[4] = { code[2*addr + 2], code[2*addr + 3], code[2*addr], code[2*addr + 1] };
-					string dat(pod);
+					char pod[4] = { code[at + 2], code[at + 3], code[at], code[at + 1] };
+					string dat(pod, 4);
 					dat = dat.substr(0, 4);
 					int d = UtilFunctions::hexToDecimal(dat);
 					Symbol* sym = localTable->getByNum(num);
@@ -247,19 +260,28 @@ void Emulator::resolveRelocation(string name) {
 						d += sym->getOffset();
 					}
 					string g = UtilFunctions::generateCode(d, 2);
-					code[2*addr] = g[0];
-					code[2*addr + 1] = g[1];
-					code[2*addr + 2] = g[2];
-					code[2*addr + 3] = g[3];
+					code[at] = g[0];
+					code[at + 1] = g[1];
+					code[at + 2] = g[2];
+					code[at + 3] = g[3];
 				}
 			}
 			genCode[UtilFunctions::getSectionNumber(sec) - 1] = code;
 		}	
 	}
-	writeToMemory(genCode, sections);
+	writeToMemory(genCode, zeroFill, sections);
+}
+
+//position in the code of a section offset
+int Emulator::codeOffset(vector<pair<int, int>>& zeroFill, int offset) {
+	int skipped = 0;
+	for (int i = 0; i < zeroFill.size(); i++) {
+		if (zeroFill[i].first + zeroFill[i].second <= offset) skipped += zeroFill[i].second;
+	}
+	return offset - skipped;
 }
 
-void Emulator::writeToMemory(string* genCode, vector<Section*> sections) {
+void Emulator::writeToMemory(string* genCode, vector<pair<int, int>>* zeroFill, vector<Section*> sections) {
 	for (int i = 0; i < sections.size()-1; i++) {
 		Section * sec = sections[i];
 		int start = sec->getStart();
@@ -268,22 +290,49 @@ void Emulator::writeToMemory(string* genCode, vector<Section*> sections) {
 		if (name == "")continue;
 		int n = UtilFunctions::getSectionNumber(name);
 		string code = genCode[n - 1];
+		vector<pair<int, int>>& holes = zeroFill[n - 1];
+		int h = 0;
 		int k = 0;
 		for (int j = 0; j < length; j++) {
+			if (h < holes.size() && holes[h].first == j) { //mapped below
+				start += holes[h].second;
+				j += holes[h].second - 1;
+				h++;
+				continue;
+			}
 			char p[] = { code[k], code[k + 1] };
-			string s(p);
+			string s(p, 2);
 			s = s.substr(0, 2);
 			mem.writeRamByte(start, s);
 			start++; 
 			k += 2;
 		}
 	}
+
+	//ZERO FILL, all of .bss is here
+	for (int i = 0; i < sections.size(); i++) {
+		string name = sections[i]->getName();
+		if (name == "") continue;
+		vector<pair<int, int>>& holes = zeroFill[UtilFunctions::getSectionNumber(name) - 1];
+		for (int h = 0; h < holes.size(); h++) mem.zeroFill(sections[i]->getStart() + holes[h].first, holes[h].second);
+	}
 }
 
 
 void Emulator::run() {
 	bool end = false;
-	Cpu* c = new Cpu(&mem);
+	Mmu* mmu = mmuEnabled ? new Mmu(&mem) : 0;
+	Cpu* c = new Cpu(&mem, mmu);
+	CacheSimulator* cache = 0;
+	if (cacheSimulation) {
+		cache = new CacheSimulator(icache, dcache, &loadedSymbols);
+		mem.attach(cache);
+	}
+	AccessHeatmap* heatmap = 0;
+	if (heatmapFile != "") {
+		heatmap = new AccessHeatmap(c->regs[Cpu::SP]);
+		mem.attach(heatmap);
+	}
 	Ivt* ivt = new Ivt(&mem);
 
 	for (int i = 0; i < 6; i++)c->regs[i] = 0;
@@ -293,10 +342,62 @@ void Emulator::run() {
 
 	if (START == -1)throw new runtime_error("ERROR: START symbol not defined");
 
+	virtualTime = 0;
+	nextTimerEvent = timerPeriod;
+	skippedTime = 0;
+	nextPace = quantum;
+	paceCount = 0;
+	jitterSum = jitterSquareSum = jitterMax = 0;
+	hostStart = chrono::steady_clock::now();
+
+	//IDLE LOOP DETECTION, only with --idle-skip
+	//a backward jump to the same address with the same registers and no memory or stack
+	//writes since the last visit repeats forever, only an interrupt can get the guest out
+	int loopHead = -1;
+	int loopRegs[9];
+	unsigned long loopWrites = 0;
+
 	while (!end) {
+		if (timerPeriod > 0 && virtualTime >= nextTimerEvent) {
+			nextTimerEvent += timerPeriod;
+			if (timerEnabled(c, ivt)) c->interrupt(ivt->getInterruptRoutine(Cpu::timer_interrupt));
+		}
+
+		if (clockRate > 0 && virtualTime >= nextPace) pace();
+
+		int oldPc = c->regs[Cpu::PC];
 		bool b = c->decodeAndExec();
+		virtualTime++;
+		if (heatmap != 0) heatmap->observeSp(c->regs[Cpu::SP]);
 		if (c->regs[Cpu::PC] > 209)break;
+
+		if (idleSkip && c->regs[Cpu::PC] <= oldPc) {
+			unsigned long writes = mem.getWriteCount() + c->stackWrites;
+			if (c->regs[Cpu::PC] == loopHead && writes == loopWrites && equal(loopRegs, loopRegs + 9, c->regs)) {
+				if (!timerEnabled(c, ivt)) {
+					LOG_WARN("Guest is idle with interrupts masked, stopping at time " << virtualTime);
+					break;
+				}
+				//FAST FORWARD TO THE NEXT TIMER TICK
+				skippedTime += nextTimerEvent - virtualTime;
+				virtualTime = nextTimerEvent;
+				loopHead = -1;
+			}
+			else {
+				loopHead = c->regs[Cpu::PC];
+				copy(c->regs, c->regs + 9, loopRegs);
+				loopWrites = writes;
+			}
+		}
+	}
+	if (skippedTime > 0) cout << "Idle time skipped: " << skippedTime << " of " << virtualTime << endl;
+	if (clockRate > 0) printPaceReport();
+	if (mmu != 0) cout << "TLB hits: " << mmu->tlbHits << ", misses: " << mmu->tlbMisses << endl;
+	if (cache != 0) {
+		ofstream report(cacheReport);
+		cache->print(report);
 	}
+	if (heatmap != 0) heatmap->print(heatmapFile);
 
 
 	//WRITE TO FILE
@@ -304,4 +405,38 @@ void Emulator::run() {
 	mem.print(out);
 	out << endl;
 	for (int i = 0; i < 9; i++)out << "r" << i << " = " << c->regs[i] << endl;
-}
\ No newline at end of file
+}
+
+//timer interrupt is accepted only when there is a timer, both the global and the timer mask
+//in psw allow it and the ivt entry is filled in
+bool Emulator::timerEnabled(Cpu* c, Ivt* ivt) {
+	if (timerPeriod == 0) return false;
+	if (!c->interruptFlag() || !c->timerFlag()) return false;
+	return ivt->getInterruptRoutine(Cpu::timer_interrupt) != 0;
+}
+
+//sleep until the host clock catches up with the virtual one, once per quantum
+void Emulator::pace() {
+	chrono::steady_clock::time_point target = hostStart + chrono::microseconds(virtualTime * 1000000 / clockRate);
+	this_thread::sleep_until(target);
+
+	double late = chrono::duration<double, micro>(chrono::steady_clock::now() - target).count();
+	if (late < 0) late = 0;
+	paceCount++;
+	jitterSum += late;
+	jitterSquareSum += late * late;
+	if (late > jitterMax) jitterMax = late;
+
+	nextPace = virtualTime - virtualTime % quantum + quantum;
+}
+
+void Emulator::printPaceReport() {
+	double elapsed = chrono::duration<double>(chrono::steady_clock::now() - hostStart).count();
+	double achieved = elapsed > 0 ? virtualTime / elapsed : 0;
+	double mean = paceCount > 0 ? jitterSum / paceCount : 0;
+	double variance = paceCount > 0 ? jitterSquareSum / paceCount - mean * mean : 0;
+	double deviation = variance > 0 ? sqrt(variance) : 0;
+
+	cout << "Target clock rate: " << clockRate << " Hz, achieved: " << (long long)achieved << " Hz" << endl;
+	cout << "Jitter over " << paceCount << " quanta: mean " << mean << " us, max " << jitterMax << " us, deviation " << deviation << " us" << endl;
+}
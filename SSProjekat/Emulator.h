@@ -3,11 +3,16 @@
 
 #include <vector>
 #include <fstream>
+#include <chrono>
+#include <stdexcept>
 #include "SymbolTable.h"
 #include "Section.h"
 #include "Memory.h"
 #include "Cpu.h"
 #include "Ivt.h"
+#include "CacheSimulator.h"
+#include "AccessHeatmap.h"
+#include "Arena.h"
 
 using namespace std;
 
@@ -15,14 +20,44 @@ using namespace std;
 class Emulator {
 private:
 	int START=-1;
+	long long virtualTime = 0;		//one unit per executed instruction
+	long long timerPeriod = 0;		//0 - no timer interrupt, as before the timer existed
+	long long nextTimerEvent = 0;
+	long long skippedTime = 0;		//virtual time skipped while the guest was idle
+	bool idleSkip = false;
+	bool mmuEnabled = false;
+
+	//THROTTLING
+	long long clockRate = 0;		//instructions per second, 0 - run as fast as possible
+	long long quantum = 0;			//instructions between two checks against the host clock
+	long long nextPace = 0;
+	chrono::steady_clock::time_point hostStart;
+	long long paceCount = 0;
+	double jitterSum = 0;			//how late the host woke up, in microseconds
+	double jitterSquareSum = 0;
+	double jitterMax = 0;
+
+	//CACHE SIMULATION
+	bool cacheSimulation = false;
+	CacheConfig icache;
+	CacheConfig dcache;
+	string cacheReport;
+	string heatmapFile;			//empty - no heatmap
+
 	SymbolTable table;
+	SymbolTable loadedSymbols;	//every defined symbol, with its address in memory, local ones as file:label
 	vector<Section*> sections;
+	Arena arena;				//sections and tables of the loaded files
 	Memory mem;
 
 	vector<string> split(string line);
 	void createSymbolTable(string name);
 	void resolveRelocation(string name);
-	void writeToMemory(string*, vector<Section*>);
+	void writeToMemory(string*, vector<pair<int, int>>*, vector<Section*>);
+	static int codeOffset(vector<pair<int, int>>& zeroFill, int offset);
+	bool timerEnabled(Cpu* c, Ivt* ivt);
+	void pace();
+	void printPaceReport();
 	
 
 public:
@@ -32,6 +67,25 @@ public:
 	void load(int, char**);
 	void run();
 
+	void setTimerPeriod(long long period) {
+		if (period <= 0) throw new runtime_error("ERROR: Timer period must be greater than 0");
+		timerPeriod = period;
+	}
+	void setIdleSkip(bool skip) { idleSkip = skip; }
+	void setMmu(bool enabled) { mmuEnabled = enabled; }
+	void setHeatmap(string fileName) { heatmapFile = fileName; }
+	void setCacheSimulation(CacheConfig icache, CacheConfig dcache, string reportFile) {
+		cacheSimulation = true;
+		this->icache = icache;
+		this->dcache = dcache;
+		cacheReport = reportFile;
+	}
+	void setClockRate(long long hz, long long quantum = 0) {
+		clockRate = hz;
+		//default quantum is one millisecond of guest time
+		this->quantum = quantum > 0 ? quantum : (hz / 1000 > 0 ? hz / 1000 : 1);
+	}
+
 
 };
 
@@ -0,0 +1,55 @@
+#ifndef ENCODER_H
+#define ENCODER_H
+
+#include <cstdint>
+
+using namespace std;
+
+//instruction word: opcode(6) | first operand(5) | second operand(5)
+//operand descriptor: addressing(2) | register(3)
+class Encoder {
+public:
+	enum Addressing { IMMEDIATE = 0, REG_DIR = 1, MEMORY = 2, REG_IND = 3 };
+
+	static constexpr int SP = 6;
+	static constexpr int PC = 7;
+
+	static constexpr uint8_t operand(Addressing addressing, int reg) {
+		return (uint8_t)((addressing << 3) | (reg & 7));
+	}
+
+	static constexpr uint8_t immediate() { return operand(IMMEDIATE, 0); }
+	static constexpr uint8_t psw() { return operand(IMMEDIATE, 7); }
+	static constexpr uint8_t regDir(int reg) { return operand(REG_DIR, reg); }
+	static constexpr uint8_t memory() { return operand(MEMORY, 0); }
+	static constexpr uint8_t regInd(int reg) { return operand(REG_IND, reg); }
+	static constexpr uint8_t pcRel() { return operand(REG_IND, PC); }
+
+	//condition(2) | operation(4)
+	static constexpr int opcode(int condition, int operation) {
+		return ((condition & 3) << 4) | (operation & 0xF);
+	}
+
+	static constexpr uint16_t instruction(int opcode, uint8_t first, uint8_t second) {
+		return (uint16_t)(((opcode & 0x3F) << 10) | ((first & 0x1F) << 5) | (second & 0x1F));
+	}
+
+	//byte i of a little endian immediate
+	template<typename T>
+	static constexpr uint8_t byte(T value, int i) {
+		return (uint8_t)((value >> (8 * i)) & 0xFF);
+	}
+
+};
+
+//WORDS PRODUCED BY THE OLD STRING ENCODER
+static_assert(Encoder::instruction(Encoder::opcode(3, 0), Encoder::regDir(1), Encoder::immediate()) == 0xC120, "aladd r1, 5");
+static_assert(Encoder::instruction(Encoder::opcode(3, 0), Encoder::regDir(Encoder::PC), Encoder::immediate()) == 0xC1E0, "aljmp $x");
+static_assert(Encoder::instruction(Encoder::opcode(3, 13), Encoder::regDir(1), Encoder::memory()) == 0xF530, "almov r1, x");
+static_assert(Encoder::instruction(Encoder::opcode(3, 13), Encoder::regDir(3), Encoder::pcRel()) == 0xF57F, "almov r3, r7[x]");
+static_assert(Encoder::instruction(Encoder::opcode(3, 10), Encoder::regDir(Encoder::PC), 0) == 0xE9E0, "alret");
+static_assert(Encoder::instruction(Encoder::opcode(3, 1), Encoder::regDir(2), Encoder::immediate()) == 0xC540, "alsub r2, 0x1f");
+static_assert(Encoder::instruction(Encoder::opcode(3, 13), Encoder::psw(), Encoder::regDir(1)) == 0xF4E9, "almov psw, r1");
+static_assert(Encoder::byte(0xFFFE, 0) == 0xFE && Encoder::byte(0xFFFE, 1) == 0xFF, "little endian -2");
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef FIXUP_H
+#define FIXUP_H
+
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+//symbol reference whose value is written once the symbol is known
+class Fixup {
+private:
+	string_view symbol; //points into the source
+	string section;
+	int offset; //byte offset of the value in the generated code of the section
+	int address; //location counter written to the relocation entry
+	int size;
+	bool relative; //true - R_386_PC32
+	int addend; //added to the value, -2 for pc relative operands
+	bool directive; //.char .word .long, local relocations point to the current section
+
+public:
+	Fixup() {}
+
+	Fixup(string_view symbol, string section, int offset, int address, int size, bool relative, int addend, bool directive) {
+		this->symbol = symbol;
+		this->section = section;
+		this->offset = offset;
+		this->address = address;
+		this->size = size;
+		this->relative = relative;
+		this->addend = addend;
+		this->directive = directive;
+	}
+
+	~Fixup() {}
+
+	string_view getSymbol() {
+		return this->symbol;
+	}
+
+	string getSection() {
+		return this->section;
+	}
+
+	int getOffset() {
+		return this->offset;
+	}
+
+	int getAddress() {
+		return this->address;
+	}
+
+	int getSize() {
+		return this->size;
+	}
+
+	bool isRelative() {
+		return this->relative;
+	}
+
+	int getAddend() {
+		return this->addend;
+	}
+
+	bool isDirective() {
+		return this->directive;
+	}
+
+};
+
+#endif
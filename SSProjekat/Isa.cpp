@@ -0,0 +1,29 @@
+#include "Isa.h"
+
+#include <stdexcept>
+
+constexpr Isa::Mnemonic Isa::MNEMONICS[];
+constexpr const char* Isa::CONDITIONS[];
+const Isa::HashTable Isa::TABLE;
+
+int Isa::find(string_view word, size_t from) {
+	if (word.size() < from + 2) return -1;
+	int i = TABLE.slots[hash(word[from], word[from + 1], word[word.size() - 1])];
+	if (i < 0 || word.compare(from, word.size() - from, MNEMONICS[i].name) != 0) return -1;
+	return i;
+}
+
+int Isa::condition(string_view instruction) {
+	if (instruction.size() < 2) return -1;
+	for (int i = 0; i < 4; i++) {
+		if (instruction[0] == CONDITIONS[i][0] && instruction[1] == CONDITIONS[i][1]) return i;
+	}
+	return -1;
+}
+
+int Isa::opcode(string_view instruction) {
+	int cond = condition(instruction);
+	int i = find(instruction, 2);
+	if (cond < 0 || i < 0) throw new runtime_error("ERROR: Unknown instruction " + string(instruction));
+	return Encoder::opcode(cond, MNEMONICS[i].operation);
+}
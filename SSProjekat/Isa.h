@@ -0,0 +1,117 @@
+#ifndef ISA_H
+#define ISA_H
+
+#include <string>
+#include <string_view>
+
+#include "Lexer.h"
+#include "Encoder.h"
+
+using namespace std;
+
+//The instruction set in one place, the assembler lookup and the cpu dispatch are both built from it
+//opcode = condition(2) | operation(4)
+class Isa {
+public:
+	enum Condition { EQ, NE, GT, AL };
+
+	enum Operation { ADD, SUB, MUL, DIV, CMP, AND, OR, NOT, TEST, PUSH, POP, CALL, IRET, MOV, SHL, SHR };
+
+	struct Mnemonic {
+		const char* name;
+		Operation operation;
+		Lexer::InstructionGroup group;
+		bool writesFlags;
+	};
+
+	static constexpr int OPERATION_COUNT = 16;
+	static constexpr int MNEMONIC_COUNT = 18;
+
+	//indexed by operation, ret and jmp are encoded as pop pc and add/mov pc
+	static constexpr Mnemonic MNEMONICS[MNEMONIC_COUNT] = {
+		{ "add", ADD, Lexer::ARITMETICAL, true },
+		{ "sub", SUB, Lexer::ARITMETICAL, true },
+		{ "mul", MUL, Lexer::ARITMETICAL, true },
+		{ "div", DIV, Lexer::ARITMETICAL, true },
+		{ "cmp", CMP, Lexer::LOGICAL, true },
+		{ "and", AND, Lexer::ARITMETICAL, true },
+		{ "or", OR, Lexer::ARITMETICAL, true },
+		{ "not", NOT, Lexer::ARITMETICAL, true },
+		{ "test", TEST, Lexer::LOGICAL, true },
+		{ "push", PUSH, Lexer::PUSHCALL, false },
+		{ "pop", POP, Lexer::POP, false },
+		{ "call", CALL, Lexer::PUSHCALL, false },
+		{ "iret", IRET, Lexer::IRET, true },
+		{ "mov", MOV, Lexer::ARITMETICAL, true },
+		{ "shl", SHL, Lexer::ARITMETICAL, true },
+		{ "shr", SHR, Lexer::ARITMETICAL, true },
+		{ "ret", POP, Lexer::RET, false },
+		{ "jmp", ADD, Lexer::JMP, false }
+	};
+
+	static constexpr const char* CONDITIONS[] = { "eq", "ne", "gt", "al" };
+
+	//PERFECT HASH OF THE MNEMONICS
+	static constexpr int HASH_SIZE = 32;
+
+	static constexpr int hash(char first, char second, char last) {
+		return (2 * first + 5 * second + 2 * last) & (HASH_SIZE - 1);
+	}
+
+	static constexpr int hash(const char* name) {
+		return hash(name[0], name[1], name[length(name) - 1]);
+	}
+
+	static constexpr int length(const char* name) {
+		return *name == 0 ? 0 : 1 + length(name + 1);
+	}
+
+	static constexpr bool hashIsPerfect() {
+		for (int i = 0; i < MNEMONIC_COUNT; i++) {
+			for (int j = i + 1; j < MNEMONIC_COUNT; j++) {
+				if (hash(MNEMONICS[i].name) == hash(MNEMONICS[j].name)) return false;
+			}
+		}
+		return true;
+	}
+
+	static constexpr bool indexedByOperation() {
+		for (int i = 0; i < OPERATION_COUNT; i++) {
+			if (MNEMONICS[i].operation != i) return false;
+		}
+		return true;
+	}
+
+	static constexpr Lexer::InstructionGroup group(int operation) {
+		return MNEMONICS[operation].group;
+	}
+
+	static constexpr bool writesFlags(int operation) {
+		return MNEMONICS[operation].writesFlags;
+	}
+
+	//index in MNEMONICS of word[from..], -1 if there is none
+	static int find(string_view word, size_t from);
+	//condition prefix of an instruction, -1 if there is none
+	static int condition(string_view instruction);
+	//opcode of an instruction, jmp gives the add form
+	static int opcode(string_view instruction);
+
+private:
+	struct HashTable {
+		signed char slots[HASH_SIZE];
+
+		constexpr HashTable() : slots() {
+			for (int i = 0; i < HASH_SIZE; i++) slots[i] = -1;
+			for (int i = 0; i < MNEMONIC_COUNT; i++) slots[hash(MNEMONICS[i].name)] = i;
+		}
+	};
+
+	static const HashTable TABLE;
+};
+
+static_assert(Isa::hashIsPerfect(), "mnemonic hash has collisions, change the hash constants");
+static_assert(Isa::indexedByOperation(), "first OPERATION_COUNT mnemonics must be in opcode order");
+static_assert(Encoder::opcode(Isa::AL, Isa::IRET) == 0x3C && Encoder::opcode(Isa::NE, Isa::IRET) == 0x1C, "iret opcodes");
+
+#endif
@@ -1,4 +1,5 @@
 #include "Ivt.h"
+#include "UtilFunctions.h"
 
 using namespace std;
 
@@ -9,6 +10,7 @@ void Ivt::init() {
 }
 
 int Ivt::getInterruptRoutine(int ivt_entry) {
-	//return memory->readRamInt(4 * ivt_entry);
-	return 0;
+	//entries are 2 bytes, little endian, starting at address 0
+	string val = memory->readRamByte(2 * ivt_entry + 1, MemoryObserver::SYSTEM) + memory->readRamByte(2 * ivt_entry, MemoryObserver::SYSTEM);
+	return UtilFunctions::hexToDecimal(val);
 }
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "Lexer.h"
+#include "Isa.h"
+#include <cstring>
+
+using namespace std;
+
+static const char* const SECTIONS[] = { "text", "data", "bss", "rodata" };
+static const char* const DIRECTIVES[] = { "char", "word", "long", "skip", "align", "incbin" };
+
+enum CharClass {
+	LETTER = 1,
+	DIGIT = 2,
+	UNDERSCORE = 4,
+	HEXLOWER = 8	//0-9 a-f
+};
+
+struct CharTable {
+	unsigned char classes[256];
+
+	CharTable() {
+		memset(classes, 0, sizeof(classes));
+		for (int c = 'a'; c <= 'z'; c++) classes[c] |= LETTER;
+		for (int c = 'A'; c <= 'Z'; c++) classes[c] |= LETTER;
+		for (int c = '0'; c <= '9'; c++) classes[c] |= DIGIT | HEXLOWER;
+		for (int c = 'a'; c <= 'f'; c++) classes[c] |= HEXLOWER;
+		classes['_'] |= UNDERSCORE;
+	}
+};
+
+static const CharTable CHARS;
+
+static inline bool is(char c, int charClass) {
+	return (CHARS.classes[(unsigned char)c] & charClass) != 0;
+}
+
+int Lexer::findIn(const char* const* table, int size, string_view word, size_t from) {
+	size_t length = word.size() - from;
+	for (int i = 0; i < size; i++) {
+		if (strlen(table[i]) == length && word.compare(from, length, table[i]) == 0) return i;
+	}
+	return -1;
+}
+
+//[0-9]+
+bool Lexer::isDecimal(string_view word, size_t from) {
+	if (from >= word.size()) return false;
+	for (size_t i = from; i < word.size(); i++) {
+		if (!is(word[i], DIGIT)) return false;
+	}
+	return true;
+}
+
+//0x[0-9a-f]+
+bool Lexer::isHex(string_view word, size_t from) {
+	if (word.size() < from + 3 || word[from] != '0' || word[from + 1] != 'x') return false;
+	for (size_t i = from + 2; i < word.size(); i++) {
+		if (!is(word[i], HEXLOWER)) return false;
+	}
+	return true;
+}
+
+//[a-zA-Z_][a-zA-Z0-9]*
+bool Lexer::isSymbol(string_view word, size_t from, size_t to) {
+	if (from >= to || !is(word[from], LETTER | UNDERSCORE)) return false;
+	for (size_t i = from + 1; i < to; i++) {
+		if (!is(word[i], LETTER | DIGIT)) return false;
+	}
+	return true;
+}
+
+Lexer::TokenType Lexer::classify(string_view word) {
+	if (word.empty()) return NONE;
+
+	if (word[0] == '.') {
+		if (findIn(SECTIONS, 4, word, 1) >= 0) return SECTION;
+		if (findIn(DIRECTIVES, 6, word, 1) >= 0) return DIRECTIVE;
+		if (word == ".global") return GLOBAL;
+		if (word == ".end") return END;
+		return NONE;
+	}
+
+	if (word[word.size() - 1] == ':') {
+		return isSymbol(word, 0, word.size() - 1) ? LABEL : NONE;
+	}
+
+	return instructionGroup(word) != NO_GROUP ? INSTRUCTION : NONE;
+}
+
+Lexer::InstructionGroup Lexer::instructionGroup(string_view word) {
+	if (word.size() < 4 || Isa::condition(word) < 0) return NO_GROUP;
+
+	int mnemonic = Isa::find(word, 2);
+	if (mnemonic < 0) return NO_GROUP;
+	return Isa::MNEMONICS[mnemonic].group;
+}
+
+Lexer::OperandType Lexer::classifyOperand(string_view word) {
+	if (word.empty()) return NOT_FOUND;
+
+	switch (word[0]) {
+	case '&':
+		return isSymbol(word, 1, word.size()) ? SYM_VAL : NOT_FOUND;
+	case '$':
+		return isSymbol(word, 1, word.size()) ? PC_REL : NOT_FOUND;
+	case '*':
+		if (isDecimal(word, 1)) return IMM_ADDR;
+		if (isHex(word, 1)) return IMM_ADDR_HEX;
+		return NOT_FOUND;
+	}
+
+	if (isDecimal(word, 0)) return IMMEDIATE_DEC;
+	if (isHex(word, 0)) return IMMEDIATE_HEX;
+	if (word == "psw") return PSW;
+
+	if (word[0] == 'r' && word.size() >= 2 && word[1] >= '0' && word[1] <= '7') {
+		if (word.size() == 2) return REG_DIR;
+		if (word[2] == '[') return REG_IND_POM;
+	}
+	if (word == "pc" || word == "sp") return REG_DIR_SPEC;
+	if (isSymbol(word, 0, word.size())) return MEM_DIR;
+
+	return NOT_FOUND;
+}
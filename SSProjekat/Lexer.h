@@ -0,0 +1,65 @@
+#ifndef LEXER_H
+#define LEXER_H
+
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+
+//Hand written classifier for assembler tokens, one pass over the characters
+//driven by a character class table, no regex engine involved
+class Lexer {
+public:
+	enum TokenType {
+		NONE,
+		LABEL,			//name:
+		SECTION,		//.text .data .bss .rodata
+		DIRECTIVE,		//.char .word .long .skip .align
+		GLOBAL,			//.global
+		END,			//.end
+		INSTRUCTION		//(eq|ne|gt|al)mnemonic
+	};
+
+	enum OperandType {
+		NOT_FOUND,
+		IMMEDIATE_DEC,	//20
+		IMMEDIATE_HEX,	//0x14
+		PSW,			//psw
+		REG_DIR,		//r0 - r7
+		REG_DIR_SPEC,	//pc sp
+		SYM_VAL,		//&sym
+		MEM_DIR,		//sym
+		IMM_ADDR,		//*20
+		IMM_ADDR_HEX,	//*0x14
+		REG_IND_POM,	//r1[...]
+		PC_REL			//$sym
+	};
+
+	enum InstructionGroup {
+		NO_GROUP,
+		ARITMETICAL,	//add, sub, mul, div, and, or, not, shl, shr, mov
+		LOGICAL,		//cmp, test
+		PUSHCALL,		//push, call
+		POP,
+		IRET,
+		RET,
+		JMP
+	};
+
+	static TokenType classify(string_view word);
+	static OperandType classifyOperand(string_view word);
+	static InstructionGroup instructionGroup(string_view word);
+
+	static bool isDecimal(string_view word) { return isDecimal(word, 0); }
+	static bool isHex(string_view word) { return isHex(word, 0); }
+	static bool isSymbol(string_view word) { return isSymbol(word, 0, word.size()); }
+
+private:
+	static bool isDecimal(string_view word, size_t from);
+	static bool isHex(string_view word, size_t from);
+	static bool isSymbol(string_view word, size_t from, size_t to);
+	static int findIn(const char* const* table, int size, string_view word, size_t from);
+};
+
+#endif
@@ -0,0 +1,18 @@
+#include "Log.h"
+
+#include <iostream>
+
+atomic<int> Log::level(LOG_LEVEL_INFO);
+
+void Log::setLevel(int level) {
+	Log::level.store(level, memory_order_relaxed);
+}
+
+int Log::getLevel() {
+	return level.load(memory_order_relaxed);
+}
+
+//a single write keeps lines of different threads apart
+void Log::write(const string& line) {
+	clog.write(line.data(), line.size());
+}
@@ -0,0 +1,61 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <atomic>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+#define LOG_LEVEL_TRACE 0	//every statement and operand
+#define LOG_LEVEL_DEBUG 1	//passes and sections
+#define LOG_LEVEL_INFO 2
+#define LOG_LEVEL_WARN 3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_OFF 5
+
+//messages under this level are not compiled at all, release builds keep only INFO and up
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL LOG_LEVEL_INFO
+#else
+#define LOG_MIN_LEVEL LOG_LEVEL_TRACE
+#endif
+#endif
+
+//Leveled diagnostics on the standard log stream, one whole line per message
+class Log {
+private:
+	static atomic<int> level;
+
+public:
+	//messages under the level are skipped at run time, INFO by default
+	static void setLevel(int level);
+	static int getLevel();
+
+	static bool enabled(int level) {
+		return level >= Log::level.load(memory_order_relaxed);
+	}
+
+	static void write(const string& line);
+};
+
+//LOG_TRACE("Next statement is: " << name), the message is only evaluated when it is printed
+#define LOG_AT(lvl, message) \
+	do { \
+		if constexpr ((lvl) >= LOG_MIN_LEVEL) { \
+			if (Log::enabled(lvl)) { \
+				ostringstream logLine; \
+				logLine << message << '\n'; \
+				Log::write(logLine.str()); \
+			} \
+		} \
+	} while (0)
+
+#define LOG_TRACE(message) LOG_AT(LOG_LEVEL_TRACE, message)
+#define LOG_DEBUG(message) LOG_AT(LOG_LEVEL_DEBUG, message)
+#define LOG_INFO(message) LOG_AT(LOG_LEVEL_INFO, message)
+#define LOG_WARN(message) LOG_AT(LOG_LEVEL_WARN, message)
+#define LOG_ERROR(message) LOG_AT(LOG_LEVEL_ERROR, message)
+
+#endif
@@ -0,0 +1,107 @@
+#include "MappedFile.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() {
+	data = 0;
+	length = 0;
+#ifdef _WIN32
+	file = INVALID_HANDLE_VALUE;
+	mapping = 0;
+#else
+	fd = -1;
+#endif
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+#ifdef _WIN32
+
+void MappedFile::open(const string& path) {
+	close();
+
+	file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	if (file == INVALID_HANDLE_VALUE) throw new runtime_error("ERROR: Can not open " + path);
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size)) {
+		close();
+		throw new runtime_error("ERROR: Can not read the size of " + path);
+	}
+	length = (size_t)size.QuadPart;
+
+	//a mapping of an empty file can not be made
+	if (length == 0) return;
+
+	mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+	if (mapping == 0) {
+		close();
+		throw new runtime_error("ERROR: Can not map " + path);
+	}
+
+	data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (data == 0) {
+		close();
+		throw new runtime_error("ERROR: Can not map " + path);
+	}
+}
+
+void MappedFile::close() {
+	if (data != 0) UnmapViewOfFile(data);
+	if (mapping != 0) CloseHandle(mapping);
+	if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+	data = 0;
+	length = 0;
+	mapping = 0;
+	file = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+void MappedFile::open(const string& path) {
+	close();
+
+	fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) throw new runtime_error("ERROR: Can not open " + path);
+
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		close();
+		throw new runtime_error("ERROR: Can not read the size of " + path);
+	}
+	length = (size_t)st.st_size;
+
+	//mmap does not accept an empty range
+	if (length == 0) return;
+
+	void* p = mmap(0, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (p == MAP_FAILED) {
+		close();
+		throw new runtime_error("ERROR: Can not map " + path);
+	}
+	data = static_cast<const char*>(p);
+
+	//the source is read front to back once per run
+	madvise(p, length, MADV_SEQUENTIAL);
+}
+
+void MappedFile::close() {
+	if (data != 0) munmap(const_cast<char*>(data), length);
+	if (fd >= 0) ::close(fd);
+	data = 0;
+	length = 0;
+	fd = -1;
+}
+
+#endif
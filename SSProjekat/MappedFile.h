@@ -0,0 +1,37 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+//Read only memory mapping of a whole file, views into it are valid until close
+class MappedFile {
+private:
+	const char* data;
+	size_t length;
+
+#ifdef _WIN32
+	void* file;		//HANDLE
+	void* mapping;	//HANDLE
+#else
+	int fd;
+#endif
+
+public:
+	MappedFile();
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	void open(const string& path);
+	void close();
+
+	string_view view() { return string_view(data, length); }
+	size_t size() { return length; }
+};
+
+#endif
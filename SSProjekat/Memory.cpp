@@ -2,16 +2,53 @@
 #include <iostream>
 using namespace std;
 
+vector<string>* Memory::findPage(int pageNumber, bool allocate) {
+	if (lastPage != 0 && lastPageNumber == pageNumber) return lastPage;
+
+	map<int, vector<string>>::iterator it = ram.find(pageNumber);
+	if (it == ram.end()) {
+		if (!allocate) return 0;
+		bool zero = zeroPages.erase(pageNumber) > 0;
+		it = ram.insert(make_pair(pageNumber, vector<string>(PAGE_SIZE, zero ? "00" : ""))).first;
+	}
+	lastPageNumber = pageNumber;
+	lastPage = &it->second;
+	return lastPage;
+}
+
 void Memory::writeRamByte(int address, string data) {
-	ram[address] = data;
+	vector<string>* page = findPage(address >> PAGE_BITS, true);
+	(*page)[address & (PAGE_SIZE - 1)] = data;
+	writeCount++;
+	for (int i = 0; i < observers.size(); i++) observers[i]->access(address, MemoryObserver::WRITE);
+}
+
+void Memory::zeroFill(int address, int length) {
+	int end = address + length;
+	while (address < end) {
+		int pageNumber = address >> PAGE_BITS;
+		int from = address & (PAGE_SIZE - 1);
+		int to = from + end - address;
+		if (to > PAGE_SIZE) to = PAGE_SIZE;
+		if (from == 0 && to == PAGE_SIZE && ram.find(pageNumber) == ram.end()) zeroPages.insert(pageNumber);
+		else {
+			vector<string>* page = findPage(pageNumber, true);
+			for (int i = from; i < to; i++) (*page)[i] = "00";
+		}
+		address += to - from;
+	}
 }
 
 void Memory::writeIoByte(int address, string data) {
 	io[address] = data;
+	writeCount++;
 }
 
-string Memory::readRamByte(int address) {
-	return ram[address];
+string Memory::readRamByte(int address, MemoryObserver::AccessType type) {
+	for (int i = 0; i < observers.size(); i++) observers[i]->access(address, type);
+	vector<string>* page = findPage(address >> PAGE_BITS, false);
+	if (page == 0) return zeroPages.count(address >> PAGE_BITS) > 0 ? "00" : "";
+	return (*page)[address & (PAGE_SIZE - 1)];
 }
 
 string Memory::readIoByte(int address) {
@@ -19,19 +56,30 @@ string Memory::readIoByte(int address) {
 }
 
 void Memory::print(ofstream& out) {
-	for (map<int, string>::iterator it = ram.begin(); it != ram.end(); it++) {
-		int add = it->first;
-		string dat = it->second;
-		out << add << "-" << dat << endl;
+	//zero pages print as if they were written
+	vector<string> zero(PAGE_SIZE, "00");
+	map<int, vector<string>*> pages;
+	for (map<int, vector<string>>::iterator it = ram.begin(); it != ram.end(); it++) pages[it->first] = &it->second;
+	for (set<int>::iterator it = zeroPages.begin(); it != zeroPages.end(); it++) pages[*it] = &zero;
+
+	for (map<int, vector<string>*>::iterator it = pages.begin(); it != pages.end(); it++) {
+		for (int i = 0; i < PAGE_SIZE; i++) {
+			string dat = (*it->second)[i];
+			if (dat == "") continue;
+			int add = (it->first << PAGE_BITS) + i;
+			out << add << "-" << dat << endl;
+		}
 	}
 
 	int p = 1;
-	for (map<int, string>::iterator it = ram.begin(); it != ram.end(); it++) {
-		int add = it->first;
-		string dat = it->second;
-		out << dat;
-		p = (p + 1) % 2;
-		if (p == 1) out << " ";
+	for (map<int, vector<string>*>::iterator it = pages.begin(); it != pages.end(); it++) {
+		for (int i = 0; i < PAGE_SIZE; i++) {
+			string dat = (*it->second)[i];
+			if (dat == "") continue;
+			out << dat;
+			p = (p + 1) % 2;
+			if (p == 1) out << " ";
+		}
 	}
 }
 
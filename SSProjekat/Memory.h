@@ -2,27 +2,51 @@
 #define MEMORY_H
 
 #include <map>
+#include <set>
+#include <vector>
 #include <string>
 #include <fstream>
 
+#include "MemoryObserver.h"
+
 using namespace std;
 
 typedef unsigned char byte;
 
 
 class Memory {
+public:
+	static const int PAGE_BITS = 8;
+	static const int PAGE_SIZE = 1 << PAGE_BITS;
+
 private:
-	map<int, string> ram;
+	//ram is sparse, a page is allocated on the first write to it
+	map<int, vector<string>> ram;
+	set<int> zeroPages;	//read as zeros, allocated on the first write
 	map<int, string> io;
+	unsigned long writeCount;
+	vector<MemoryObserver*> observers;
+
+	int lastPageNumber;
+	vector<string>* lastPage;
+	vector<string>* findPage(int pageNumber, bool allocate);
+
 public:
-	Memory() {};
+	Memory() { writeCount = 0; lastPageNumber = 0; lastPage = 0; };
 	~Memory() {};
 
 	void writeRamByte(int address, string data);
 	void writeIoByte(int address, string data);
-	string readRamByte(int address);
+	//loads zeros, whole pages are only marked
+	void zeroFill(int address, int length);
+	string readRamByte(int address, MemoryObserver::AccessType type = MemoryObserver::READ);
 	string readIoByte(int address);
 
+	//number of writes so far, lets the emulator prove a loop has no side effects
+	unsigned long getWriteCount() { return writeCount; }
+
+	void attach(MemoryObserver* observer) { observers.push_back(observer); }
+
 	void print(ofstream& out);
 };
 
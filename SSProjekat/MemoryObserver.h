@@ -0,0 +1,18 @@
+#ifndef MEMORYOBSERVER_H
+#define MEMORYOBSERVER_H
+
+using namespace std;
+
+
+//Instrumentation plugin, Memory calls it for every ram access once it is attached
+class MemoryObserver {
+public:
+	//SYSTEM - read by the emulator itself (interrupt vector, page table walk), not by the guest program
+	enum AccessType { FETCH, READ, WRITE, SYSTEM };
+
+	virtual ~MemoryObserver() {}
+
+	virtual void access(int address, AccessType type) = 0;
+};
+
+#endif // !MEMORYOBSERVER_H
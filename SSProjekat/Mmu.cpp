@@ -0,0 +1,69 @@
+#include "Mmu.h"
+#include <stdexcept>
+
+using namespace std;
+
+Mmu::Mmu(Memory* memory) {
+	this->memory = memory;
+	enabled = false;
+	ptbr = 0;
+	tlbHits = 0;
+	tlbMisses = 0;
+	flush();
+}
+
+void Mmu::flush() {
+	for (int i = 0; i < TLB_SIZE; i++) tlb[i].page = -1;
+}
+
+int Mmu::readIoWord(int address) {
+	string val = memory->readIoByte(address + 1) + memory->readIoByte(address); //little endian!
+	if (val == "") return 0;
+	return stoi(val, 0, 16);
+}
+
+string Mmu::read(int address, MemoryObserver::AccessType type) {
+	address &= 0xFFFF;
+	if (address >= IO_START) return memory->readIoByte(address);
+	return memory->readRamByte(translate(address), type);
+}
+
+void Mmu::write(int address, string data) {
+	address &= 0xFFFF;
+	if (address >= IO_START) {
+		memory->writeIoByte(address, data);
+		if (address == MMU_CONTROL || address == MMU_CONTROL + 1 || address == MMU_PTBR || address == MMU_PTBR + 1) {
+			enabled = readIoWord(MMU_CONTROL) & 1;
+			ptbr = readIoWord(MMU_PTBR);
+			flush();
+		}
+		return;
+	}
+	memory->writeRamByte(translate(address), data);
+}
+
+int Mmu::translate(int address) {
+	if (!enabled) return address;
+
+	int page = address >> Memory::PAGE_BITS;
+	TlbEntry& e = tlb[page & (TLB_SIZE - 1)];
+	if (e.page == page) {
+		tlbHits++;
+		return e.frame + (address & (Memory::PAGE_SIZE - 1));
+	}
+
+	tlbMisses++;
+	e.frame = walk(page);
+	e.page = page;
+	return e.frame + (address & (Memory::PAGE_SIZE - 1));
+}
+
+//page table lives in guest physical memory
+int Mmu::walk(int page) {
+	int entry = (ptbr << Memory::PAGE_BITS) + 2 * page;
+	string val = memory->readRamByte(entry + 1, MemoryObserver::SYSTEM) + memory->readRamByte(entry, MemoryObserver::SYSTEM);
+	int pte = val == "" ? 0 : stoi(val, 0, 16);
+
+	if ((pte & 0x8000) == 0) throw new runtime_error("ERROR: Page fault, page " + to_string(page) + " is not mapped");
+	return (pte & 0x7FFF) << Memory::PAGE_BITS;
+}
@@ -0,0 +1,47 @@
+#ifndef MMU_H
+#define MMU_H
+
+#include <string>
+#include "Memory.h"
+
+using namespace std;
+
+
+//Optional paging unit between the cpu and memory.
+//Virtual addresses are 16 bit, a page table entry is a little endian word:
+//bit 15 - valid, bits 0-14 - physical frame number
+class Mmu {
+private:
+	static const int TLB_SIZE = 16;
+
+	struct TlbEntry {
+		int page;	//-1 - invalid
+		int frame;	//physical address of the frame
+	};
+
+	Memory* memory;
+	bool enabled;
+	int ptbr;		//frame number of the page table
+	TlbEntry tlb[TLB_SIZE];
+
+	int translate(int address);
+	int walk(int page);
+	int readIoWord(int address);
+	void flush();
+
+public:
+	static const int IO_START = 0xFF00;	//not translated, goes to the io space
+	static const int MMU_CONTROL = 0xFF10;	//bit 0 - translation on, every write flushes the tlb
+	static const int MMU_PTBR = 0xFF12;
+
+	long long tlbHits;
+	long long tlbMisses;
+
+	Mmu(Memory* memory);
+	~Mmu() {}
+
+	string read(int address, MemoryObserver::AccessType type = MemoryObserver::READ);
+	void write(int address, string data);
+};
+
+#endif // !MMU_H
@@ -0,0 +1,105 @@
+#ifndef OBJECTMODULE_H
+#define OBJECTMODULE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Symbol.h"
+#include "RelocationSymbol.h"
+#include "CodeBuffer.h"
+
+using namespace std;
+
+
+//One error of the source, line 0 when it does not belong to a single line
+class Diagnostic {
+private:
+	int line;
+	string message;
+
+public:
+	Diagnostic(int line, string message) {
+		this->line = line;
+		this->message = message;
+	}
+
+	int getLine() {
+		return this->line;
+	}
+	string getMessage() {
+		return this->message;
+	}
+};
+
+
+//Section of an assembled object, the same as in the section table and the code of the object file
+class ObjectSection {
+private:
+	string name;
+	int start;
+	int length;
+	vector<uint8_t> bytes;					//without the zero fill
+	vector<CodeBuffer::Extent> zeroFill;	//sorted by offset
+	vector<RelocationSymbol> relocations;
+
+public:
+	ObjectSection(string name, int start, int length) {
+		this->name = name;
+		this->start = start;
+		this->length = length;
+	}
+
+	string getName() {
+		return this->name;
+	}
+	int getStart() {
+		return this->start;
+	}
+	int getLength() {
+		return this->length;
+	}
+	vector<uint8_t>& getBytes() {
+		return this->bytes;
+	}
+	vector<CodeBuffer::Extent>& getZeroFill() {
+		return this->zeroFill;
+	}
+	vector<RelocationSymbol>& getRelocations() {
+		return this->relocations;
+	}
+};
+
+
+//Everything an object file holds, in memory. It does not point into the source.
+class ObjectModule {
+private:
+	vector<ObjectSection> sections;	//in the order of the section table
+	vector<Symbol> symbols;			//in the order they were defined, the object file sorts them by name
+	vector<Diagnostic> diagnostics;
+
+public:
+	//false if the source has errors, there are no sections and symbols then
+	bool ok() {
+		return diagnostics.empty();
+	}
+
+	vector<ObjectSection>& getSections() {
+		return this->sections;
+	}
+	//0 if there is no such section
+	ObjectSection* getSection(string name) {
+		for (int i = 0; i < sections.size(); i++) {
+			if (sections[i].getName() == name) return &sections[i];
+		}
+		return 0;
+	}
+	vector<Symbol>& getSymbols() {
+		return this->symbols;
+	}
+	vector<Diagnostic>& getDiagnostics() {
+		return this->diagnostics;
+	}
+};
+
+#endif
@@ -0,0 +1,200 @@
+#include "Peephole.h"
+#include "Isa.h"
+#include "Encoder.h"
+#include "Lexer.h"
+#include "UtilFunctions.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+Peephole::Peephole(vector<Statement>& statements, SymbolTable* table, Arena& arena) : statements(statements), arena(arena) {
+	this->table = table;
+	removed = 0;
+	folded = 0;
+	shortened = 0;
+}
+
+//a removal can make the jump before it a jump to the next instruction, so again until nothing changes
+int Peephole::run() {
+	int before = 0;
+	do {
+		before = removed + folded + shortened;
+		scan();
+		for (int s = 0; s < statements.size(); s++) {
+			if (statements[s].type != Lexer::INSTRUCTION || !text[s]) continue;
+
+			if (foldJump(s)) folded++;
+			if (jumpToNext(s) || (isNoOp(s) && flagsDead(s + 1))) {
+				statements[s].type = Lexer::NONE;
+				removed++;
+			}
+			else if (shorten(s)) shortened++;
+		}
+		compact();
+	} while (removed + folded + shortened != before);
+
+	return removed + folded + shortened;
+}
+
+//WHICH STATEMENTS ARE IN .text AND WHERE ITS LABELS ARE
+void Peephole::scan() {
+	text.assign(statements.size(), false);
+	labels.clear();
+	string_view section = "";
+	for (int s = 0; s < statements.size(); s++) {
+		Statement& st = statements[s];
+		if (st.type == Lexer::SECTION) section = st.name;
+		text[s] = section == ".text";
+
+		if (st.type == Lexer::LABEL && text[s]) {
+			Symbol* sym = table->get(st.name);
+			if (sym != 0 && sym->getLocGlo() == "local" && sym->getSection() == ".text") labels[st.name] = s;
+		}
+	}
+}
+
+//DROP THE REMOVED INSTRUCTIONS
+void Peephole::compact() {
+	statements.erase(remove_if(statements.begin(), statements.end(), [](Statement& st) { return st.type == Lexer::NONE; }), statements.end());
+}
+
+//jmp $a ... a: aljmp $b -> jmp $b, the addressing of the first jump stays
+bool Peephole::foldJump(int s) {
+	Statement& st = statements[s];
+	string_view target = jumpTarget(st);
+	if (target.empty()) return false;
+
+	vector<string_view> chain(1, target);
+	while (chain.size() <= MAX_CHAIN) {
+		int t = nextCode(labels[chain.back()]);
+		if (t >= statements.size()) break;
+		Statement& next = statements[t];
+		if (next.type != Lexer::INSTRUCTION || Isa::condition(next.name) != Isa::AL) break;
+
+		string_view further = jumpTarget(next);
+		if (further.empty()) break;
+		if (find(chain.begin(), chain.end(), further) != chain.end()) return false; //jumps in a loop
+		chain.push_back(further);
+	}
+	if (chain.size() == 1) return false;
+
+	string* op = arena.make<string>(string(1, st.operands[0].text[0]) + string(chain.back()));
+	st.operands[0].text = *op;
+	return true;
+}
+
+//only labels and removed instructions between the jump and its target
+bool Peephole::jumpToNext(int s) {
+	string_view target = jumpTarget(statements[s]);
+	if (target.empty()) return false;
+
+	for (int u = s + 1; u < statements.size(); u++) {
+		Statement& st = statements[u];
+		if (st.type == Lexer::LABEL && st.name == target) return true;
+		if (st.type != Lexer::LABEL && st.type != Lexer::GLOBAL && st.type != Lexer::NONE) return false;
+	}
+	return false;
+}
+
+bool Peephole::isNoOp(int s) {
+	Statement& st = statements[s];
+	if (Lexer::instructionGroup(st.name) != Lexer::ARITMETICAL || st.operands.size() != 2) return false;
+
+	int reg = registerNumber(st.operands[0]);
+	if (reg < 0 || reg == Encoder::PC) return false;
+
+	switch (Isa::MNEMONICS[Isa::find(st.name, 2)].operation) {
+	case Isa::ADD:
+	case Isa::SUB:
+	case Isa::OR:
+	case Isa::SHL:
+	case Isa::SHR:
+		return immediateIs(st.operands[1], 0);
+	case Isa::MUL:
+	case Isa::DIV:
+		return immediateIs(st.operands[1], 1);
+	case Isa::MOV:
+		return registerNumber(st.operands[1]) == reg;
+	default:
+		return false;
+	}
+}
+
+//mov rX, 0 -> sub rX, rX, the immediate word is gone
+bool Peephole::shorten(int s) {
+	Statement& st = statements[s];
+	if (Lexer::instructionGroup(st.name) != Lexer::ARITMETICAL || st.operands.size() != 2) return false;
+	if (Isa::MNEMONICS[Isa::find(st.name, 2)].operation != Isa::MOV) return false;
+
+	int reg = registerNumber(st.operands[0]);
+	if (reg < 0 || reg == Encoder::PC || !immediateIs(st.operands[1], 0) || !flagsDead(s + 1)) return false;
+
+	string* name = arena.make<string>(string(Isa::CONDITIONS[Isa::condition(st.name)]) + "sub");
+	st.name = *name;
+	st.operands[1] = st.operands[0];
+	return true;
+}
+
+//true if the flags are written again before anything can read them,
+//anything that leaves the straight line (jumps, calls, writes to pc, data) counts as a read
+bool Peephole::flagsDead(int from) {
+	for (int t = from; t < statements.size(); t++) {
+		Statement& st = statements[t];
+		if (st.type == Lexer::LABEL || st.type == Lexer::GLOBAL || st.type == Lexer::NONE) continue;
+		if (st.type != Lexer::INSTRUCTION) return false;
+
+		const Isa::Mnemonic& m = Isa::MNEMONICS[Isa::find(st.name, 2)];
+		if (Isa::condition(st.name) != Isa::AL) return false;
+		if (m.group == Lexer::JMP || m.group == Lexer::RET || m.group == Lexer::IRET || m.operation == Isa::CALL) return false;
+		for (int k = 0; k < st.operands.size(); k++) {
+			if (st.operands[k].type == Lexer::PSW) return false;
+		}
+		if (!st.operands.empty() && registerNumber(st.operands[0]) == Encoder::PC) return false;
+
+		if (m.writesFlags) return true;
+	}
+	return false;
+}
+
+//first statement from the index on that makes code or ends a section
+int Peephole::nextCode(int from) {
+	int t = from;
+	while (t < statements.size()) {
+		Lexer::TokenType type = statements[t].type;
+		if (type != Lexer::LABEL && type != Lexer::GLOBAL && type != Lexer::NONE) break;
+		t++;
+	}
+	return t;
+}
+
+//local .text label a jmp $label or jmp &label goes to, empty for any other instruction
+string_view Peephole::jumpTarget(Statement& st) {
+	if (Lexer::instructionGroup(st.name) != Lexer::JMP || st.operands.empty()) return string_view();
+
+	Operand& op = st.operands[0];
+	if (op.type != Lexer::PC_REL && op.type != Lexer::SYM_VAL) return string_view();
+
+	string_view name = op.text.substr(1);
+	if (labels.count(name) == 0) return string_view();
+	return name;
+}
+
+int Peephole::registerNumber(Operand& op) {
+	if (op.type == Lexer::REG_DIR) return op.text[1] - '0';
+	if (op.type == Lexer::REG_DIR_SPEC) return op.text == "sp" ? Encoder::SP : Encoder::PC;
+	return -1;
+}
+
+bool Peephole::immediateIs(Operand& op, int value) {
+	try {
+		if (op.type == Lexer::IMMEDIATE_DEC) return UtilFunctions::toInt(op.text) == value;
+		//the encoder skips a digit of hex immediates, the written and the encoded value must both match
+		if (op.type == Lexer::IMMEDIATE_HEX) {
+			return UtilFunctions::hexValue(op.text.substr(2)) == value && UtilFunctions::hexValue(op.text.substr(3)) == value;
+		}
+	}
+	catch (exception& e) {
+	}
+	return false;
+}
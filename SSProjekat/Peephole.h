@@ -0,0 +1,63 @@
+#ifndef PEEPHOLE_H
+#define PEEPHOLE_H
+
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Statement.h"
+#include "SymbolTable.h"
+#include "Arena.h"
+
+using namespace std;
+
+//Optional pass between the first and the second run, it only rewrites instructions in .text:
+//- no-ops (add/sub/or/shl/shr rX, 0, mul/div rX, 1, mov rX, rX) are removed
+//- jumps to the next instruction are removed
+//- a jump to an unconditional jump goes straight to the end of the chain
+//- mov rX, 0 becomes sub rX, rX, two bytes instead of four
+//Removing or shortening an instruction that writes flags is only done when nothing reads them before
+//they are written again, flags are the ones of the instruction set (Isa::writesFlags), jumps keep them.
+//Labels of a removed instruction stay where they are and so name the next one,
+//offsets are stale afterwards, the compiler lays the sections out again.
+class Peephole {
+public:
+	Peephole(vector<Statement>& statements, SymbolTable* table, Arena& arena);
+
+	//number of changed instructions
+	int run();
+
+	int getRemoved() { return removed; }
+	int getFolded() { return folded; }
+	int getShortened() { return shortened; }
+
+private:
+	static constexpr int MAX_CHAIN = 16;
+
+	void scan();
+	void compact();
+
+	bool foldJump(int s);
+	bool jumpToNext(int s);
+	bool isNoOp(int s);
+	bool shorten(int s);
+	bool flagsDead(int from);
+
+	int nextCode(int from);
+	string_view jumpTarget(Statement& st);
+	static int registerNumber(Operand& op);
+	static bool immediateIs(Operand& op, int value);
+
+	vector<Statement>& statements;
+	SymbolTable* table;
+	Arena& arena;	//text of rewritten operands and mnemonics
+
+	vector<bool> text;	//statement is in .text
+	unordered_map<string_view, int> labels;	//local labels of .text
+
+	int removed;
+	int folded;
+	int shortened;
+};
+
+#endif
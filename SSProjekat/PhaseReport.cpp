@@ -0,0 +1,148 @@
+#include "PhaseReport.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+//COUNTING HEAP, every new of the process goes through here, it only counts while a report exists
+static atomic<int> activeReports(0);
+static atomic<long long> allocationCount(0);
+static atomic<long long> allocationBytes(0);
+
+void* operator new(size_t size) {
+	if (activeReports.load(memory_order_relaxed) != 0) {
+		allocationCount.fetch_add(1, memory_order_relaxed);
+		allocationBytes.fetch_add(size, memory_order_relaxed);
+	}
+	void* p = malloc(size == 0 ? 1 : size);
+	if (p == 0) throw bad_alloc();
+	return p;
+}
+
+void operator delete(void* p) noexcept {
+	free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+	free(p);
+}
+
+const char* const PhaseReport::NAMES[PHASES] = { "reading", "tokenizing", "pass one", "peephole", "pass two", "relocations", "writing" };
+
+PhaseReport::PhaseReport() {
+	for (int i = 0; i < PHASES; i++) phases[i] = Counters{ 0, 0, 0 };
+	innermost = 0;
+	mode = "";
+	lines = 0;
+	symbols = 0;
+	relocations = 0;
+	arenaBytes = 0;
+	arenaRecords = 0;
+	activeReports.fetch_add(1, memory_order_relaxed);
+}
+
+PhaseReport::~PhaseReport() {
+	activeReports.fetch_sub(1, memory_order_relaxed);
+}
+
+PhaseReport::Scope::Scope(PhaseReport* report, Phase phase) {
+	this->report = report;
+	this->phase = phase;
+	outer = 0;
+	allocations = 0;
+	allocatedBytes = 0;
+	innerSeconds = 0;
+	innerAllocations = 0;
+	innerBytes = 0;
+	if (report == 0) return;
+
+	outer = report->innermost;
+	report->innermost = this;
+	allocations = PhaseReport::allocations();
+	allocatedBytes = PhaseReport::allocatedBytes();
+	start = chrono::steady_clock::now();
+}
+
+PhaseReport::Scope::~Scope() {
+	if (report == 0) return;
+
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	long long count = PhaseReport::allocations() - allocations;
+	long long bytes = PhaseReport::allocatedBytes() - allocatedBytes;
+
+	Counters& c = report->phases[phase];
+	c.seconds += seconds - innerSeconds;
+	c.allocations += count - innerAllocations;
+	c.allocatedBytes += bytes - innerBytes;
+
+	report->innermost = outer;
+	if (outer != 0) {
+		outer->innerSeconds += seconds;
+		outer->innerAllocations += count;
+		outer->innerBytes += bytes;
+	}
+}
+
+long long PhaseReport::allocations() {
+	return allocationCount.load(memory_order_relaxed);
+}
+
+long long PhaseReport::allocatedBytes() {
+	return allocationBytes.load(memory_order_relaxed);
+}
+
+long long PhaseReport::peakMemory() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+	return counters.PeakWorkingSetSize;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+	return usage.ru_maxrss;			//bytes
+#else
+	return usage.ru_maxrss * 1024LL;	//kilobytes
+#endif
+#endif
+}
+
+void PhaseReport::print(string fileName) {
+	ofstream out(fileName);
+	Counters total = { 0, 0, 0 };
+	for (int i = 0; i < PHASES; i++) {
+		total.seconds += phases[i].seconds;
+		total.allocations += phases[i].allocations;
+		total.allocatedBytes += phases[i].allocatedBytes;
+	}
+
+	out << "{" << endl;
+	out << "  \"mode\": \"" << mode << "\"," << endl;
+	out << "  \"lines\": " << lines << "," << endl;
+	out << "  \"symbols\": " << symbols << "," << endl;
+	out << "  \"relocations\": " << relocations << "," << endl;
+	out << "  \"arenaBytes\": " << arenaBytes << "," << endl;
+	out << "  \"arenaRecords\": " << arenaRecords << "," << endl;
+	out << "  \"peakMemory\": " << peakMemory() << "," << endl;
+	out << "  \"seconds\": " << total.seconds << "," << endl;
+	out << "  \"allocations\": " << total.allocations << "," << endl;
+	out << "  \"allocatedBytes\": " << total.allocatedBytes << "," << endl;
+	out << "  \"phases\": [";
+	for (int i = 0; i < PHASES; i++) {
+		Counters c = phases[i];
+		if (i > 0) out << ",";
+		out << endl << "    { \"phase\": \"" << NAMES[i] << "\", \"seconds\": " << c.seconds
+			<< ", \"allocations\": " << c.allocations << ", \"allocatedBytes\": " << c.allocatedBytes << " }";
+	}
+	out << endl << "  ]" << endl << "}" << endl;
+}
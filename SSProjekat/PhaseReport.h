@@ -0,0 +1,86 @@
+#ifndef PHASEREPORT_H
+#define PHASEREPORT_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+using namespace std;
+
+
+//Wall time and heap allocations of every phase of one compilation, plus the sizes of the input
+//and the output, written as json. Allocations are counted by the global operator new of the
+//whole process, so threads of the second run are included in the phase that started them.
+//The counting is off unless a report exists, then it costs a load per allocation.
+class PhaseReport {
+public:
+	enum Phase { READING, TOKENIZING, PASS_ONE, PEEPHOLE, PASS_TWO, RELOCATIONS, WRITING, PHASES };
+
+	//Measures a phase until it goes out of scope, nothing without a report.
+	//A scope inside another one is not counted in the outer phase, scopes of a report
+	//must be opened and closed on one thread.
+	class Scope {
+	private:
+		PhaseReport* report;
+		Phase phase;
+		Scope* outer;
+		chrono::steady_clock::time_point start;
+		long long allocations;
+		long long allocatedBytes;
+		//of the scopes inside, taken off at the end
+		double innerSeconds;
+		long long innerAllocations;
+		long long innerBytes;
+
+	public:
+		Scope(PhaseReport* report, Phase phase);
+		~Scope();
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	};
+
+	PhaseReport();
+	~PhaseReport();
+
+	PhaseReport(const PhaseReport&) = delete;
+	PhaseReport& operator=(const PhaseReport&) = delete;
+
+	void setMode(string mode) { this->mode = mode; }
+	void setLines(int lines) { this->lines = lines; }
+	void setSymbols(int symbols) { this->symbols = symbols; }
+	void setRelocations(int relocations) { this->relocations = relocations; }
+	void setArena(size_t bytes, size_t records) { arenaBytes = bytes; arenaRecords = records; }
+
+	double getSeconds(Phase phase) { return phases[phase].seconds; }
+	long long getAllocations(Phase phase) { return phases[phase].allocations; }
+
+	//made while any report existed
+	static long long allocations();
+	static long long allocatedBytes();
+	//peak resident memory of the process in bytes, 0 where it is not known
+	static long long peakMemory();
+
+	void print(string fileName);
+
+private:
+	struct Counters {
+		double seconds;
+		long long allocations;
+		long long allocatedBytes;
+	};
+
+	static const char* const NAMES[PHASES];
+
+	Counters phases[PHASES];
+	Scope* innermost;
+
+	string mode;
+	int lines;
+	int symbols;
+	int relocations;
+	size_t arenaBytes;
+	size_t arenaRecords;
+};
+
+#endif
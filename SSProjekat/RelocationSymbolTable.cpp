@@ -17,8 +17,8 @@ RelocationSymbolTable::RelocationSymbolTable() {
 
 }
 
-bool RelocationSymbolTable::put(string key, RelocationSymbol* sym) {
-	table[key].push_back(*sym);
+bool RelocationSymbolTable::put(string key, RelocationSymbol sym) {
+	table[key].push_back(sym);
 	//rs.push_back(*sym);
 	return 1;
 }
@@ -28,6 +28,12 @@ vector<RelocationSymbol> RelocationSymbolTable::get(string key) {
 	return sym;
 }
 
+int RelocationSymbolTable::size() {
+	int count = 0;
+	for (map<string, vector<RelocationSymbol>>::iterator iter = table.begin(); iter != table.end(); iter++) count += iter->second.size();
+	return count;
+}
+
 void RelocationSymbolTable::print(ofstream& outFile) {
 	for (map<string, vector<RelocationSymbol>>::iterator iter = table.begin(); iter != table.end(); iter++) {
 		vector<RelocationSymbol> v = iter->second;
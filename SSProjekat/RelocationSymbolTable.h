@@ -16,8 +16,9 @@ public:
 	RelocationSymbolTable();
 	~RelocationSymbolTable() {}
 
-	bool put(string key, RelocationSymbol* sym);
+	bool put(string key, RelocationSymbol sym);
 	vector<RelocationSymbol> get(string key);
+	int size();
 
 	void print(ofstream& outFile);
 
@@ -0,0 +1,106 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+//Bounded ring buffer between exactly one producer thread and one consumer thread.
+//No locks while items flow, each side only writes its own index. A full or empty queue is waited on
+//with a few yields, then the thread sleeps until the other side moves (a slow pipe must not burn a core).
+template<typename T>
+class SpscQueue {
+private:
+	vector<T> slots;
+	size_t mask;
+
+	alignas(64) atomic<size_t> head;	//next slot to pop, written by the consumer
+	alignas(64) atomic<size_t> tail;	//next slot to push, written by the producer
+	atomic<bool> cancelled;
+
+	//SLEEPING, only used once the spinning gave up
+	static const int SPINS = 64;
+	mutex sleepMutex;
+	condition_variable awake;
+	atomic<int> sleepers;
+
+	//false if the queue was cancelled before ready
+	template<typename Ready>
+	bool waitFor(Ready ready) {
+		for (int i = 0; i < SPINS; i++) {
+			if (ready()) return true;
+			if (cancelled.load(memory_order_acquire)) return false;
+			this_thread::yield();
+		}
+
+		unique_lock<mutex> lock(sleepMutex);
+		sleepers.fetch_add(1, memory_order_relaxed);
+		//pairs with the fence in wake, either this side sees the new index or the other one sees the sleeper
+		atomic_thread_fence(memory_order_seq_cst);
+		bool ok = true;
+		while (!ready()) {
+			if (cancelled.load(memory_order_acquire)) {
+				ok = false;
+				break;
+			}
+			awake.wait(lock);
+		}
+		sleepers.fetch_sub(1, memory_order_relaxed);
+		return ok;
+	}
+
+	//called after an index moved
+	void wake() {
+		atomic_thread_fence(memory_order_seq_cst);
+		if (sleepers.load(memory_order_relaxed) == 0) return;
+		lock_guard<mutex> lock(sleepMutex);
+		awake.notify_all();
+	}
+
+public:
+	//capacity is rounded up to a power of two
+	SpscQueue(size_t capacity) : head(0), tail(0), cancelled(false), sleepers(0) {
+		size_t size = 1;
+		while (size < capacity) size *= 2;
+		slots.resize(size);
+		mask = size - 1;
+	}
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	//false if the queue was cancelled while waiting for room
+	bool push(T item) {
+		size_t t = tail.load(memory_order_relaxed);
+		if (!waitFor([&] { return t - head.load(memory_order_acquire) != slots.size(); })) return false;
+		slots[t & mask] = move(item);
+		tail.store(t + 1, memory_order_release);
+		wake();
+		return true;
+	}
+
+	//false if the queue was cancelled while empty, items pushed before that are still returned
+	bool pop(T& item) {
+		size_t h = head.load(memory_order_relaxed);
+		if (!waitFor([&] { return tail.load(memory_order_acquire) != h; })) return false;
+		item = move(slots[h & mask]);
+		head.store(h + 1, memory_order_release);
+		wake();
+		return true;
+	}
+
+	//wakes both sides, used when one of them stops early
+	void cancel() {
+		cancelled.store(true, memory_order_release);
+		lock_guard<mutex> lock(sleepMutex);
+		awake.notify_all();
+	}
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef STATEMENT_H
+#define STATEMENT_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Lexer.h"
+
+using namespace std;
+
+
+class Operand {
+public:
+	string_view text;			//points into the source
+	Lexer::OperandType type;	//only classified for instruction operands
+
+	Operand(string_view text, Lexer::OperandType type) {
+		this->text = text;
+		this->type = type;
+	}
+};
+
+
+//One parsed statement, the first run builds them and the second run encodes them
+//without going back to the source text, the source must stay alive until then
+class Statement {
+public:
+	Lexer::TokenType type;		//LABEL, SECTION, DIRECTIVE, GLOBAL, INSTRUCTION or END
+	string_view name;			//label, section, directive or mnemonic
+	vector<Operand> operands;	//instruction operands or directive arguments
+	int line;
+	int offset;					//location counter in the section, for instructions and directives
+	string_view data;			//bytes of .incbin, points into a mapped file
+
+	Statement(Lexer::TokenType type, string_view name, int line) {
+		this->type = type;
+		this->name = name;
+		this->line = line;
+		this->offset = 0;
+	}
+};
+
+#endif
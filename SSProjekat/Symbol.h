@@ -27,7 +27,7 @@ public:
 
 	~Symbol() {}
 
-	string getLabel() {
+	const string& getLabel() {
 		return this->label;
 	}
 
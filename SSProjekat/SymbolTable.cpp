@@ -1,36 +1,102 @@
 #include "SymbolTable.h"
+#include <algorithm>
+#include <utility>
 #include <fstream>
 
-bool SymbolTable::put(string key, Symbol* sym) {
-	Symbol* s = table[key];
-	if (s != 0) {
+SymbolTable::SymbolTable() {
+	slots.assign(16, -1);
+}
+
+//FNV-1a
+uint32_t SymbolTable::hash(string_view key) {
+	uint32_t h = 2166136261u;
+	for (int i = 0; i < key.size(); i++) {
+		h ^= (unsigned char)key[i];
+		h *= 16777619u;
+	}
+	return h;
+}
+
+//slot of the key, or the empty slot where it would go
+int SymbolTable::find(string_view key, uint32_t h) {
+	int mask = slots.size() - 1;
+	for (int i = h & mask; ; i = (i + 1) & mask) {
+		int s = slots[i];
+		if (s < 0) return i;
+		if (hashes[s] == h && symbols[s].getLabel() == key) return i;
+	}
+}
+
+void SymbolTable::grow() {
+	slots.assign(slots.size() * 2, -1);
+	int mask = slots.size() - 1;
+	for (int s = 0; s < hashes.size(); s++) {
+		int i = hashes[s] & mask;
+		while (slots[i] >= 0) i = (i + 1) & mask;
+		slots[i] = s;
+	}
+}
+
+bool SymbolTable::put(Symbol sym) {
+	uint32_t h = hash(sym.getLabel());
+	int slot = find(sym.getLabel(), h);
+	if (slots[slot] >= 0) {
 		return 0;
 	}
-	table[key] = sym;
+
+	//the first symbol with a number keeps it
+	int num = sym.getNumber();
+	if (num >= 0) {
+		if (num >= byNumber.size()) byNumber.resize(num + 1, -1);
+		if (byNumber[num] < 0) byNumber[num] = symbols.size();
+	}
+
+	slots[slot] = symbols.size();
+	symbols.push_back(move(sym));
+	hashes.push_back(h);
+
+	//keep the load factor under one half
+	if (2 * symbols.size() > slots.size()) grow();
 	return 1;
 }
 
-Symbol* SymbolTable::get(string key) {
-	Symbol* sym = table[key];
+Symbol* SymbolTable::get(string_view key) {
+	int s = slots[find(key, hash(key))];
+	if (s < 0) return 0;
+	return &symbols[s];
+}
+
+Symbol* SymbolTable::getByNum(int num) {
+	if (num < 0 || num >= byNumber.size() || byNumber[num] < 0) return 0;
+	return &symbols[byNumber[num]];
+}
+
+vector<Symbol*> SymbolTable::getSymbols() {
+	vector<Symbol*> ret;
+	for (int s = 0; s < symbols.size(); s++) {
+		ret.push_back(&symbols[s]);
+	}
+	return ret;
+}
 
-	if (sym == 0)return 0;
-	return sym;
+int SymbolTable::size() {
+	return symbols.size();
 }
 
 void SymbolTable::print(ofstream& outFile) {
 	outFile << "Label" << "\t\t" << "Section" << "\t\t" << "offset" << "\t\t" << "LocGlo" << "\t\t" << "number" << endl;
 	outFile << "--------------------------------------------------------------------------" << endl;
-	for (map<string, Symbol*>::iterator it = table.begin(); it != table.end(); it++ ) {
-		Symbol * s = it->second;
-		outFile << s->getLabel() << "\t\t" << s->getSection() << "\t\t" << s->getOffset() << "\t\t" << s->getLocGlo() << "\t\t" << s->getNumber() << endl;
-	}
-	
-}
 
-Symbol* SymbolTable::getByNum(int num) {
-	for (map<string, Symbol*>::iterator it = table.begin(); it != table.end(); it++) {
-		Symbol * s = it->second;
-		if (s->getNumber() == num)return s;
+	//BY NAME
+	vector<int> order(symbols.size());
+	for (int s = 0; s < order.size(); s++) order[s] = s;
+	sort(order.begin(), order.end(), [this](int a, int b) {
+		return symbols[a].getLabel() < symbols[b].getLabel();
+	});
+
+	for (int i = 0; i < order.size(); i++) {
+		Symbol& s = symbols[order[i]];
+		outFile << s.getLabel() << "\t\t" << s.getSection() << "\t\t" << s.getOffset() << "\t\t" << s.getLocGlo() << "\t\t" << s.getNumber() << endl;
 	}
-	return 0;
-}
\ No newline at end of file
+
+}
@@ -1,25 +1,41 @@
 #ifndef SYMBOLTABLE_H
 #define SYMBOLTABLE_H
 
+#include <cstdint>
 #include <string>
-#include <map>
+#include <string_view>
+#include <vector>
 #include <iostream>
 
 #include "Symbol.h"
 
 using namespace std;
 
+//Symbols are stored by value in insertion order and indexed by their own labels
+//with an open addressing hash table, numbers with a direct index
 class SymbolTable {
 private:
-	map<string, Symbol*> table;
+	vector<Symbol> symbols;
+	vector<uint32_t> hashes;	//of the labels, same order as symbols
+	vector<int> slots;		//index in symbols, -1 when empty
+	vector<int> byNumber;	//symbol number -> index in symbols, -1 when there is none
+
+	static uint32_t hash(string_view key);
+	int find(string_view key, uint32_t h);
+	void grow();
 
 public:
-	SymbolTable() {}
+	SymbolTable();
 	~SymbolTable() {}
 
-	bool put(string key, Symbol* sym);
-	Symbol* get(string key);
+	//pointers returned by get and getByNum are valid until the next put
+	//the number of a symbol must not change after put. Two symbols can have the same number
+	//(globals of different files), getByNum gives the first one put
+	bool put(Symbol sym);
+	Symbol* get(string_view key);
 	Symbol* getByNum(int num);
+	vector<Symbol*> getSymbols();
+	int size();
 
 	void print(ofstream& outFile);
 };
@@ -0,0 +1,58 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int threads) {
+	pending = 0;
+	stopping = false;
+
+	if (threads <= 0) threads = thread::hardware_concurrency();
+	if (threads <= 0) threads = 1;
+
+	for (int i = 0; i < threads; i++) {
+		workers.push_back(thread(&ThreadPool::work, this));
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		unique_lock<mutex> guard(lock);
+		stopping = true;
+	}
+	hasWork.notify_all();
+
+	for (int i = 0; i < workers.size(); i++) {
+		workers[i].join();
+	}
+}
+
+void ThreadPool::submit(function<void()> task) {
+	{
+		unique_lock<mutex> guard(lock);
+		tasks.push(move(task));
+		pending++;
+	}
+	hasWork.notify_one();
+}
+
+void ThreadPool::wait() {
+	unique_lock<mutex> guard(lock);
+	idle.wait(guard, [this] { return pending == 0; });
+}
+
+void ThreadPool::work() {
+	while (true) {
+		function<void()> task;
+		{
+			unique_lock<mutex> guard(lock);
+			hasWork.wait(guard, [this] { return stopping || !tasks.empty(); });
+			if (tasks.empty()) return;
+			task = move(tasks.front());
+			tasks.pop();
+		}
+
+		task();
+
+		unique_lock<mutex> guard(lock);
+		pending--;
+		if (pending == 0) idle.notify_all();
+	}
+}
@@ -0,0 +1,43 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+//Fixed number of workers taking tasks in the order they were submitted
+class ThreadPool {
+private:
+	vector<thread> workers;
+	queue<function<void()>> tasks;
+
+	mutex lock;
+	condition_variable hasWork;
+	condition_variable idle;
+	int pending;	//submitted and not finished yet
+	bool stopping;
+
+	void work();
+
+public:
+	//0 - one worker per hardware thread
+	ThreadPool(int threads = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	//tasks must not throw
+	void submit(function<void()> task);
+	//blocks until every submitted task is finished
+	void wait();
+
+	int size() { return workers.size(); }
+};
+
+#endif
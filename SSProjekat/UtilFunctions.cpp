@@ -1,34 +1,34 @@
 #include "UtilFunctions.h"
 
-using namespace std;
+#include <cctype>
+#include <charconv>
+#include <stdexcept>
 
-vector<string> UtilFunctions::split(string line) {
-	vector<string> ret;
-	string word="";
+using namespace std;
 
-	/*
-	while (getline(ss, word, ' ')) {
-		ret.push_back(word);
-	}
-	*/
+//words of the line point into it, no copies are made
+void UtilFunctions::split(string_view line, vector<string_view>& words) {
+	words.clear();
+	size_t start = 0;
 
-	for (int i = 0; i < line.size(); i++) {
-		if (line.at(i) != ' ' && line.at(i) != ',')word += line.at(i);
-		else if(word!="" && word!="\n") {
-			ret.push_back(word);
-			word = "";
+	for (size_t i = 0; i < line.size(); i++) {
+		//a word in quotes keeps its spaces and commas
+		if (line[i] == '"') {
+			size_t close = line.find('"', i + 1);
+			i = close == string_view::npos ? line.size() - 1 : close;
+			continue;
 		}
+		if (line[i] != ' ' && line[i] != ',') continue;
+		if (i > start) words.push_back(line.substr(start, i - start));
+		start = i + 1;
 	}
 
-	if (word != "" && word != "\n") {
-		ret.push_back(word);
+	if (line.size() > start) {
+		words.push_back(line.substr(start));
 	}
-
-
-	return ret;
 }
 
-int UtilFunctions::getDirectiveSize(string directive) {
+int UtilFunctions::getDirectiveSize(string_view directive) {
 	if (directive == ".char") return 1;
 	else if (directive == ".word") return 2;
 	else if (directive == ".long") return 4;
@@ -36,7 +36,7 @@ int UtilFunctions::getDirectiveSize(string directive) {
 	return 0;
 }
 
-int UtilFunctions::getSectionNumber(string section) {
+int UtilFunctions::getSectionNumber(string_view section) {
 	if (section == ".text") return 1;
 	else if (section == ".data") return 2;
 	else if (section == ".rodata") return 3;
@@ -180,6 +180,28 @@ string UtilFunctions::generateCode(int num, int size) {
 	else throw runtime_error("ERROR: Unexpected error");	
 }
 
+//only the first four digits fit in a word
+int UtilFunctions::hexValue(string_view digits) {
+	if (digits.size() == 0) return 0;
+	digits = digits.substr(0, 4);
+	int ret = 0;
+	from_chars_result r = from_chars(digits.data(), digits.data() + digits.size(), ret, 16);
+	if (r.ec != errc() || r.ptr == digits.data()) throw invalid_argument("ERROR: Not a hexadecimal number");
+	return ret;
+}
+
+//same as stoi, without making a string
+int UtilFunctions::toInt(string_view digits) {
+	while (digits.size() > 0 && isspace((unsigned char)digits[0])) digits.remove_prefix(1);
+	if (digits.size() > 1 && digits[0] == '+' && digits[1] != '-') digits.remove_prefix(1);
+
+	int ret = 0;
+	from_chars_result r = from_chars(digits.data(), digits.data() + digits.size(), ret);
+	if (r.ec == errc::result_out_of_range) throw out_of_range("ERROR: Number is too big");
+	if (r.ec != errc() || r.ptr == digits.data()) throw invalid_argument("ERROR: Not a number");
+	return ret;
+}
+
 int UtilFunctions::hexToDecimal(string num) {
 	int ret = 0;
 	int i = num.size() - 1;
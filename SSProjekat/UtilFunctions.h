@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <fstream>
 #include <math.h>
 #include <bitset>
@@ -13,9 +14,9 @@ using namespace std;
 
 class UtilFunctions{
 public:
-	static vector<string> split(string line);
-	static int getDirectiveSize(string directive);
-	static int getSectionNumber(string section);
+	static void split(string_view line, vector<string_view>& words);
+	static int getDirectiveSize(string_view directive);
+	static int getSectionNumber(string_view section);
 
 	static string decimalToBinary(int number);
 	static string binaryToHexa(string binary);
@@ -24,6 +25,8 @@ public:
 	static string generateCode(int, int);
 
 	static int hexToDecimal(string num);
+	static int hexValue(string_view digits);
+	static int toInt(string_view digits);
 	static string hexToBinary(string hex);
 	static int binaryToDec(string bin);
 };
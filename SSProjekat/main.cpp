@@ -1,45 +1,139 @@
 #include <iostream>
 #include <fstream>
+#include <cstdio>
 #include <exception>
+#include <string>
+#include <vector>
 
 #include "Compiler.h"
+#include "BatchAssembler.h"
+#include "Log.h"
 
 using namespace std;
 
 /*
+//./compiler --batch [--jobs=N] [--start=address] [--single-pass] [--optimize] [--fixed] [--cache=dir] [--verbose] inputFile+
+//every x.s is assembled to x.o, the files are spread over the threads
+int batch(int argc, char** argv) {
+	int threads = 0;
+	int startAddress = 0;
+	bool singlePass = false;
+	bool optimize = false;
+	bool fixedAddresses = false;
+	string cacheDirectory = "";
+	vector<string> inputs;
+
+	for (int i = 2; i < argc; i++) {
+		string arg = argv[i];
+		if (arg.compare(0, 7, "--jobs=") == 0) threads = stoi(arg.substr(7));
+		else if (arg.compare(0, 8, "--start=") == 0) startAddress = stoi(arg.substr(8));
+		else if (arg == "--single-pass") singlePass = true;
+		else if (arg == "--optimize") optimize = true;
+		else if (arg == "--fixed") fixedAddresses = true;
+		else if (arg.compare(0, 8, "--cache=") == 0) cacheDirectory = arg.substr(8);
+		else if (arg == "--verbose") Log::setLevel(LOG_LEVEL_TRACE); //debug builds only
+		else inputs.push_back(arg);
+	}
+
+	BatchAssembler assembler(threads);
+	assembler.setSinglePass(singlePass);
+	assembler.setOptimize(optimize);
+	assembler.setFixedAddresses(fixedAddresses);
+	assembler.setStartAddress(startAddress);
+	if (cacheDirectory != "") assembler.setCache(cacheDirectory);
+	for (int i = 0; i < inputs.size(); i++) assembler.add(inputs[i], BatchAssembler::outputFor(inputs[i]));
+
+	int failed = assembler.run();
+
+	//REPORT IN THE ORDER OF THE ARGUMENTS
+	vector<BatchAssembler::Job>& jobs = assembler.getJobs();
+	for (int i = 0; i < jobs.size(); i++) {
+		if (!jobs[i].ok) cout << jobs[i].input << ": " << jobs[i].error << endl;
+	}
+	cout << jobs.size() - failed << " of " << jobs.size() << " files assembled" << endl;
+	if (assembler.getCache() != 0) cout << assembler.getCache()->getHits() << " taken from the cache" << endl;
+
+	return failed > 0 ? 4 : 0;
+}
+
 int main(int argc, char** argv) {
 
+	if (argc > 1 && string(argv[1]) == "--batch") return batch(argc, argv);
+
 	if (argc < 3) {
-		cout << "Please call this program as ./compiler inputFile outputFile" << endl;
+		cout << "Please call this program as ./compiler inputFile|- outputFile [startAddress] [--single-pass] [--optimize] [--fixed] [--threads=N] [--cache=dir] [--time-report=file.json] [--verbose]" << endl;
+		cout << "or as ./compiler --batch [--jobs=N] [--start=address] [--single-pass] [--optimize] [--fixed] [--cache=dir] [--verbose] inputFile+" << endl;
 		return 1;
 	}
 
-	ifstream inFile(argv[1]);
-	ofstream outFile(argv[2]);
+	bool singlePass = false;
+	bool optimize = false;
+	bool fixedAddresses = false;
+	int threads = 1;
+	string cacheDirectory = "";
+	string timeReport = "";
+	for (; argc > 3; argc--) {
+		string flag = argv[argc - 1];
+		if (flag == "--single-pass") singlePass = true;
+		else if (flag == "--optimize") optimize = true;
+		else if (flag == "--fixed") fixedAddresses = true;
+		else if (flag.compare(0, 10, "--threads=") == 0) threads = stoi(flag.substr(10));
+		else if (flag.compare(0, 8, "--cache=") == 0) cacheDirectory = flag.substr(8);
+		else if (flag.compare(0, 14, "--time-report=") == 0) timeReport = flag.substr(14);
+		else if (flag == "--verbose") Log::setLevel(LOG_LEVEL_TRACE); //debug builds only
+		else break;
+	}
+
 	int startAddress = 0;
-	if (argc >= 3) {
+	if (argc > 3) {
 		string s = argv[3];
 		startAddress = stoi(s);
 	}
 
-	if (!inFile.is_open()) {
-		cerr << "There was an error while opening the input file" << endl;
-		return 2;
+	//UNCHANGED SOURCE, the object is taken from the cache, there is nothing to time then
+	AssemblyCache* cache = 0;
+	string key = "";
+	if (cacheDirectory != "" && string(argv[1]) != "-" && timeReport == "") {
+		cache = new AssemblyCache(cacheDirectory);
+		int options = 0;
+		if (optimize && !singlePass) options |= AssemblyCache::OPTIMIZED;
+		if (fixedAddresses) options |= AssemblyCache::FIXED_ADDRESSES;
+		key = AssemblyCache::keyOfFile(argv[1], startAddress, options);
+		if (key != "" && cache->fetch(key, argv[2])) {
+			delete cache;
+			cout << "Success, taken from the cache" << endl;
+			return 0;
+		}
 	}
 
+	remove(argv[2]); //may be a link into the cache made by an older build
+	ofstream outFile(argv[2]);
+
 	if (!outFile.is_open()) {
 		cerr << "There was an error while opening the output file" << endl;
 		return 3;
 	}
 
 	Compiler* c = new Compiler();
-	c->compile(inFile, outFile, startAddress);
+	c->setSinglePass(singlePass);
+	c->setThreads(threads);
+	c->setOptimize(optimize); //ignored with --single-pass and for "-"
+	c->setFixedAddresses(fixedAddresses);
+	PhaseReport report;
+	if (timeReport != "") c->setReport(&report);
+	bool ok;
+	if (string(argv[1]) == "-") ok = c->compileStream(cin, outFile, startAddress); //from a pipe, assembled while it arrives
+	else ok = c->compileFile(argv[1], outFile, startAddress);
+	if (!ok) cout << c->getError() << endl;
 
 	delete c;
-	inFile.close();
 	outFile.close();
+	if (ok && timeReport != "") report.print(timeReport);
+
+	if (ok && key != "") cache->store(key, argv[2]);
+	delete cache;
 
-	cout << "Success" << endl;
+	if (ok) cout << "Success" << endl;
 
 	int in;
 	cin >> in;
@@ -1,11 +1,22 @@
 #include <iostream>
 #include <vector>
 #include <fstream>
+#include <string>
+#include <cstdio>
 
 #include "Emulator.h"
+#include "Log.h"
 
 using namespace std;
 
+//size,associativity,line size
+CacheConfig parseCacheConfig(string arg) {
+	CacheConfig c;
+	if (sscanf(arg.c_str(), "%d,%d,%d", &c.size, &c.associativity, &c.lineSize) != 3) {
+		throw new runtime_error("ERROR: Cache is given as size,associativity,line");
+	}
+	return c;
+}
 
 int main(int argc, char** argv) {
 	if (argc < 1){
@@ -15,7 +26,31 @@ int main(int argc, char** argv) {
 
 	Emulator* e = new Emulator();
 
-	e->load(argc, argv);
+	//OPTIONS, everything else is passed to the loader
+	vector<char*> args;
+	long long clock = 0, quantum = 0;
+	bool cache = false;
+	CacheConfig icache = { 1024, 2, 16 };
+	CacheConfig dcache = { 1024, 2, 16 };
+	string cacheReport = "cacheReport.txt";
+	for (int i = 0; i < argc; i++) {
+		string arg = argv[i];
+		if (arg.compare(0, 8, "--clock=") == 0) clock = stoll(arg.substr(8));
+		else if (arg.compare(0, 10, "--quantum=") == 0) quantum = stoll(arg.substr(10));
+		else if (arg.compare(0, 8, "--timer=") == 0) e->setTimerPeriod(stoll(arg.substr(8)));
+		else if (arg == "--idle-skip") e->setIdleSkip(true);
+		else if (arg == "--mmu") e->setMmu(true);
+		else if (arg == "--verbose") Log::setLevel(LOG_LEVEL_TRACE); //debug builds only
+		else if (arg.compare(0, 10, "--heatmap=") == 0) e->setHeatmap(arg.substr(10));
+		else if (arg.compare(0, 9, "--icache=") == 0) { icache = parseCacheConfig(arg.substr(9)); cache = true; }
+		else if (arg.compare(0, 9, "--dcache=") == 0) { dcache = parseCacheConfig(arg.substr(9)); cache = true; }
+		else if (arg.compare(0, 15, "--cache-report=") == 0) { cacheReport = arg.substr(15); cache = true; }
+		else args.push_back(argv[i]);
+	}
+	if (clock > 0) e->setClockRate(clock, quantum);
+	if (cache) e->setCacheSimulation(icache, dcache, cacheReport);
+
+	e->load(args.size(), args.data());
 	e->run();
 
 	int n;
@@ -0,0 +1,144 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <set>
+
+#include "Compiler.h"
+#include "Emulator.h"
+#include "ObjectModule.h"
+#include "SymbolTable.h"
+
+using namespace std;
+
+//Checks symbol numbers, relocations name symbols by them:
+//- a global declared with .global before its label keeps its own number
+//- the loader refuses an object where two symbols have the same number
+//- getByNum gives the first symbol put with a number
+//./symbolCheck, the exit code is the number of failed checks
+
+
+//START and b are declared before their labels, the old assembler gave them the numbers of a and c
+static const char* const SOURCE =
+	".global START, b\n"
+	".text\n"
+	"START: almov r1, b\n"
+	" almov r2, &b\n"
+	" aljmp 300\n"
+	".data\n"
+	"a: .word 5\n"
+	"b: .word 6\n"
+	"c: .word 7\n"
+	".end\n";
+
+//the same source as the old assembler wrote it, b and c are both 8
+static const char* const OLD_OBJECT =
+	"#Section_table\n"
+	"Section name\tStart\t\tLength\n"
+	".text\t\t100\t\t12\n"
+	".data\t\t112\t\t6\n"
+	"\n"
+	"#Symbol_table\n"
+	"Label\t\tSection\t\toffset\t\tLocGlo\t\tnumber\n"
+	"--------------------------------------------------------------------------\n"
+	".data\t\t.data\t\t12\t\tlocal\t\t2\n"
+	".text\t\t.text\t\t0\t\tlocal\t\t1\n"
+	"START\t\t.text\t\t0\t\tglobal\t\t7\n"
+	"a\t\t.data\t\t0\t\tlocal\t\t7\n"
+	"b\t\t.data\t\t2\t\tglobal\t\t8\n"
+	"c\t\t.data\t\t4\t\tlocal\t\t8\n"
+	"\n"
+	"#.rel.text\n"
+	"2\t\tR_386_32\t\t8\n"
+	"6\t\tR_386_32\t\t8\n"
+	"\n"
+	"#.data\n"
+	"050006000700\n"
+	"#.text\n"
+	"F5300000F5400000F5E02C01\n"
+	"#.rodata\n"
+	"\n";
+
+static int fail(string message) {
+	cout << "FAILED: " << message << endl;
+	return 1;
+}
+
+static int checkAssembler() {
+	Compiler compiler;
+	ObjectModule object = compiler.assemble(SOURCE, 100);
+	if (!object.ok()) return fail("the source does not assemble: " + object.getDiagnostics()[0].getMessage());
+
+	int failed = 0;
+	set<int> numbers;
+	int b = -1;
+	for (Symbol& s : object.getSymbols()) {
+		if (!numbers.insert(s.getNumber()).second) failed += fail(s.getLabel() + " has the number of another symbol");
+		if (s.getLabel() == "b") b = s.getNumber();
+	}
+
+	ObjectSection* text = object.getSection(".text");
+	if (text == 0 || text->getRelocations().size() != 2) return failed + fail("both instructions need a relocation for b");
+	for (RelocationSymbol& r : text->getRelocations()) {
+		if (r.getNumber() != b) failed += fail("relocation at " + r.getAddress() + " is not for b");
+	}
+	return failed;
+}
+
+static bool loads(string fileName) {
+	char program[] = "symbolCheck";
+	char last[] = "x";	//the loader skips the last argument
+	char* argv[] = { program, &fileName[0], last };
+	Emulator e;
+	try {
+		e.load(3, argv);
+	}
+	catch (runtime_error* err) {
+		cout << err->what() << endl;
+		delete err;
+		return false;
+	}
+	return true;
+}
+
+static int checkLoader() {
+	int failed = 0;
+
+	//compile reads a file, so the source goes through one
+	ofstream source("symbolCheck.s");
+	source << SOURCE;
+	source.close();
+
+	Compiler compiler;
+	ifstream in("symbolCheck.s");
+	ofstream out("symbolCheck.o");
+	if (!compiler.compile(in, out, 100)) return fail("the source does not assemble: " + compiler.getError());
+	out.close();
+	if (!loads("symbolCheck.o")) failed += fail("the assembled object does not load");
+
+	ofstream old("symbolCheckOld.o");
+	old << OLD_OBJECT;
+	old.close();
+	if (loads("symbolCheckOld.o")) failed += fail("an object with two symbols numbered 8 loads");
+
+	remove("symbolCheck.s");
+	remove("symbolCheck.o");
+	remove("symbolCheckOld.o");
+	return failed;
+}
+
+static int checkTable() {
+	SymbolTable table;
+	table.put(Symbol("first", ".data", 0, "global", 6));
+	table.put(Symbol("second", ".data", 2, "global", 6));
+	Symbol* s = table.getByNum(6);
+	if (s == 0 || s->getLabel() != "first") return fail("getByNum(6) is not the first symbol put with number 6");
+	if (table.getByNum(7) != 0) return fail("getByNum(7) found a symbol");
+	return 0;
+}
+
+int main() {
+	int failed = checkAssembler() + checkLoader() + checkTable();
+	if (failed == 0) cout << "Symbol numbers are unique" << endl;
+	else cout << failed << " checks failed" << endl;
+	return failed;
+}